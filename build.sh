@@ -1,3 +1,6 @@
-g++ -I. -I /usr/include/kea -L /usr/lib/kea/lib -fpic -shared -o interfaces_cmds.so \
-  interfaces_cmds.cc interfaces_cmds_callouts.cc version.cc interfaces_cmds_messages.cc interfaces_cmds_log.cc  \
-  -lkea-dhcpsrv -lkea-dhcp -lkea-hooks -lkea-log -lkea-util -lkea-exceptions -lcurl
+g++ ${CXXFLAGS} -I. -I /usr/include/kea -L /usr/lib/kea/lib -fpic -shared -o interfaces_cmds.so \
+  interfaces_cmds.cc interfaces_cmds_callouts.cc version.cc interfaces_cmds_messages.cc interfaces_cmds_log.cc interfaces_cmds_tag_index.cc \
+  interfaces_cmds_iface_edit.cc interfaces_cmds_counters.cc interfaces_cmds_sibling.cc \
+  interfaces_cmds_snapshots.cc interfaces_cmds_trace.cc \
+  -lkea-dhcpsrv -lkea-dhcp -lkea-hooks -lkea-stats -lkea-log -lkea-util -lkea-exceptions -lcurl
+g++ -O2 -pthread -o interfaces_cmds_loadgen interfaces_cmds_loadgen.cc
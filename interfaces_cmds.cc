@@ -1,15 +1,30 @@
 #include <config.h>
 
+#include <asiolink/io_address.h>
 #include <cc/command_interpreter.h>
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
 #include <dhcpsrv/cfgmgr.h>
 #include <process/daemon.h>
+#include <stats/stats_mgr.h>
+#include <util/multi_threading_mgr.h>
 
+#include <limits>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <interfaces_cmds.h>
+#include <interfaces_cmds_counters.h>
+#include <interfaces_cmds_family.h>
+#include <interfaces_cmds_iface_edit.h>
 #include <interfaces_cmds_log.h>
+#include <interfaces_cmds_sibling.h>
+#include <interfaces_cmds_snapshots.h>
+#include <interfaces_cmds_tag_index.h>
+#include <interfaces_cmds_trace.h>
 
 #include "cc/data.h"
 #include "dhcp/iface_mgr.h"
@@ -20,46 +35,97 @@
 #include "hooks/callout_handle.h"
 #include "log/macros.h"
 
+using namespace isc::asiolink;
 using namespace isc::config;
 using namespace isc::dhcp;
 using namespace isc::data;
 using namespace isc::hooks;
 using namespace isc::util;
 using namespace isc::process;
+using namespace isc::stats;
 using namespace std;
 
 namespace {
     string dhcp4_config_path = "";
     string dhcp6_config_path = "";
+    uint16_t server_port = 0;
+    string dhcp4_control_socket = "";
+    string dhcp6_control_socket = "";
+
+    /// @brief Time in milliseconds to wait for each I/O step with the sibling daemon.
+    const int SIBLING_TIMEOUT = 5000;
+
+    /// @brief Command handlers of the server protocol family, created at load.
+    boost::shared_ptr<isc::interfaces_cmds::InterfacesCmdsImpl> implementation;
 }  // namespace
 
 namespace isc {
     namespace interfaces_cmds {
 
         void
-        storeConfiguration(string dhcp4_config_path_param, string dhcp6_config_path_param) {
+        storeConfiguration(string dhcp4_config_path_param, string dhcp6_config_path_param,
+                           uint16_t server_port_param, string dhcp4_control_socket_param,
+                           string dhcp6_control_socket_param) {
             dhcp4_config_path = dhcp4_config_path_param;
             dhcp6_config_path = dhcp6_config_path_param;
+            server_port = server_port_param;
+            dhcp4_control_socket = dhcp4_control_socket_param;
+            dhcp6_control_socket = dhcp6_control_socket_param;
         }
 
         void
         clearConfiguration() {
             dhcp4_config_path = "";
             dhcp6_config_path = "";
+            server_port = 0;
+            dhcp4_control_socket = "";
+            dhcp6_control_socket = "";
+            implementation.reset();
         }
 
         /// @brief Implementation of the @c InterfacesCmds class.
         ///
-        /// It provides functions for class manipulations.
+        /// The handlers are implemented once per protocol family by @c InterfacesCmdsFamilyImpl,
+        /// the family of the server is selected once when the library is loaded.
         class InterfacesCmdsImpl {
         public:
-            /// @brief Constructor.
-            InterfacesCmdsImpl() {
-                family_ = CfgMgr::instance().getFamily();
+            /// @brief Destructor.
+            virtual ~InterfacesCmdsImpl() {
             }
 
-            /// @brief Destructor.
-            ~InterfacesCmdsImpl() {
+            virtual void getAvailableInterfaces(CalloutHandle& handle) = 0;
+
+            virtual void getInterfaces(CalloutHandle& handle) = 0;
+
+            virtual void appendInterfaces(CalloutHandle& handle) = 0;
+
+            virtual void deleteInterfaces(CalloutHandle& handle) = 0;
+
+            virtual void getInterfacesSettings(CalloutHandle& handle) = 0;
+
+            virtual void setInterfacesSettings(CalloutHandle& handle) = 0;
+
+            virtual void getInterfacesSnapshots(CalloutHandle& handle) = 0;
+
+            virtual void rollbackInterfaces(CalloutHandle& handle) = 0;
+
+#if defined(INTERFACES_CMDS_TRACING)
+            virtual void dumpTrace(CalloutHandle& handle) = 0;
+#endif
+        };
+
+        /// @brief Command handlers specialized for a protocol family.
+        ///
+        /// @tparam Family Protocol family traits, @c Family4 or @c Family6.
+        template<typename Family>
+        class InterfacesCmdsFamilyImpl : public InterfacesCmdsImpl {
+        public:
+            /// @brief Constructor.
+            ///
+            /// @param config_path Configuration file of the server.
+            /// @param sibling_control_socket Control socket of the other DHCP daemon, empty if not set.
+            InterfacesCmdsFamilyImpl(const string& config_path, const string& sibling_control_socket)
+                : config_path_(config_path), sibling_control_socket_(sibling_control_socket) {
             }
 
         private:
@@ -73,6 +139,7 @@ namespace isc {
             /// @throw CtrlChannelError if the arguments are not present or aren't
             /// a map.
             ConstElementPtr getMandatoryArguments(CalloutHandle& callout_handle) const {
+                INTERFACES_CMDS_TRACE_SPAN("parse-command");
                 ConstElementPtr command;
                 callout_handle.getArgument("command", command);
                 ConstElementPtr arguments;
@@ -85,6 +152,7 @@ namespace isc {
             /// @param command_name Command name, used for error reporting.
             /// @param arguments Command arguments to be parsed and validated.
             void validateArguments(const string& command_name, const ConstElementPtr& arguments) {
+                INTERFACES_CMDS_TRACE_SPAN("validate-arguments");
                 // If no parameter sections are specified, no command API should be available.
                 ConstElementPtr section = arguments->get("section");
                 if (!section) {
@@ -120,24 +188,68 @@ namespace isc {
                         isc_throw(BadValue, "'interfaces' argument specified for the '"
                         << command_name << "' command is not a list of string");
                     }
+
+                    // In the subnet section the first interface of the list is used.
+                    if (section_value == "subnet" && interfaces->empty()) {
+                        isc_throw(BadValue, "'interfaces' argument specified for the '"
+                        << command_name << "' command in the \"subnet\" section is empty");
+                    }
+                }
+
+                // The dual-stack mode forwards global changes to the sibling daemon, subnet IDs are
+                // not shared between the DHCPv4 and DHCPv6 servers.
+                ConstElementPtr family = arguments->get("family");
+                if (family) {
+                    if (family->getType() != Element::string || family->stringValue() != "both") {
+                        isc_throw(BadValue, "invalid value in param 'family' for the '"
+                        << command_name << "' command. Expected \"both\"");
+                    }
+
+                    if (command_name != "append-interfaces" && command_name != "delete-interfaces") {
+                        isc_throw(BadValue, "'family' argument is not supported by the '"
+                        << command_name << "' command");
+                    }
+
+                    if (section_value != "global") {
+                        isc_throw(BadValue, "'family' argument for the '" << command_name
+                        << "' command requires the \"global\" section");
+                    }
+
+                    if (getSiblingControlSocket().empty()) {
+                        isc_throw(BadValue, "'family' argument for the '" << command_name
+                        << "' command requires the '" << Family::siblingName()
+                        << "-control-socket' hook parameter");
+                    }
                 }
 
-                // If the subnet configuration is affected, its ID must also be obtained.
+                // If the subnet configuration is affected, its ID or a user-context selector
+                // matching a set of subnets must also be obtained.
                 if ((command_name == "get-interfaces" || command_name == "append-interfaces" ||
                     command_name == "delete-interfaces") &&
                     section_value == "subnet") {
                     ConstElementPtr subnet_id = arguments->get("subnet_id");
-                if (!subnet_id) {
-                    isc_throw(BadValue, "missing 'subnet_id' argument for the '"
-                    << command_name
-                    << "' command. (Type argument - unsigned integer)");
-                }
+                    ConstElementPtr selector = arguments->get("user-context");
+                    if (!subnet_id && !selector) {
+                        isc_throw(BadValue, "missing 'subnet_id' or 'user-context' argument for the '"
+                        << command_name
+                        << "' command. (Type argument - unsigned integer or map)");
+                    }
 
-                if (subnet_id->getType() != Element::integer) {
-                    isc_throw(BadValue, "'subnet_id' argument specified for the '"
-                    << command_name << "' command is not a unsigned integer");
-                }
+                    if (subnet_id && selector) {
+                        isc_throw(BadValue, "'subnet_id' and 'user-context' arguments specified for the '"
+                        << command_name << "' command are mutually exclusive");
+                    }
+
+                    if (subnet_id && subnet_id->getType() != Element::integer) {
+                        isc_throw(BadValue, "'subnet_id' argument specified for the '"
+                        << command_name << "' command is not a unsigned integer");
                     }
+
+                    if (selector && (selector->getType() != Element::map || selector->empty())) {
+                        isc_throw(BadValue, "'user-context' argument specified for the '"
+                        << command_name << "' command is not a non-empty map");
+                    }
+                }
             }
 
             /// @brief Writes the current server configuration to a JSON configuration file.
@@ -147,16 +259,22 @@ namespace isc {
 
                     Daemon daemon = Daemon{};
 
-                    string filename;
-                    if (family_ == AF_INET) {
-                        filename = dhcp4_config_path;
-                    } else {
-                        filename = dhcp6_config_path;
+                    ConstElementPtr cfg;
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("to-element");
+                        cfg = CfgMgr::instance().getCurrentCfg()->toElement();
                     }
 
-                    ConstElementPtr cfg = CfgMgr::instance().getCurrentCfg()->toElement();
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("write-config-file");
+                        daemon.writeConfigFile(config_path_, cfg);
+                    }
 
-                    daemon.writeConfigFile(filename, cfg);
+                    // Every persisted change is recorded, so it can be rolled back.
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("snapshot-capture");
+                        InterfacesSnapshots::capture<Family>();
+                    }
                     return (createAnswer(CONTROL_RESULT_SUCCESS, "Configuration updated successfully."));
                 } catch (const isc::Exception& ex) {
                     return (createAnswer(CONTROL_RESULT_ERROR,
@@ -164,12 +282,394 @@ namespace isc {
                 }
             }
 
+            /// @brief Republishes a snapshot in the current configuration.
+            ///
+            /// The global interfaces, their settings and the subnets interfaces are replaced while
+            /// packet processing is paused, so no packet sees a partially restored configuration.
+            /// When the sockets can not be reopened for the restored socket type, the replaced
+            /// configuration is republished and its sockets are reopened before the error is thrown.
+            ///
+            /// @param snapshot Snapshot to apply.
+            /// @param previous Snapshot of the configuration being replaced.
+            void applySnapshot(const InterfacesSnapshotPtr& snapshot, const InterfacesSnapshotPtr& previous) {
+                MultiThreadingCriticalSection cs;
+
+                if (!restoreSnapshot(snapshot)) {
+                    return;
+                }
+
+                try {
+                    reopenSockets();
+                } catch (const exception& ex) {
+                    ostringstream text;
+                    text << "failed to reopen the sockets: " << ex.what() << ", previous configuration restored";
+                    static_cast<void>(restoreSnapshot(previous));
+                    try {
+                        reopenSockets();
+                    } catch (const exception& restore_ex) {
+                        text << ", reopening the previous sockets failed: " << restore_ex.what();
+                    }
+                    isc_throw(Unexpected, text.str());
+                }
+            }
+
+            /// @brief Replaces the interfaces configuration with the one of a snapshot.
+            ///
+            /// Only the subnets whose interface differs from the snapshot are modified. Must be
+            /// called with packet processing paused.
+            ///
+            /// @param snapshot Snapshot to restore.
+            ///
+            /// @return true if the socket type changed and the sockets must be reopened.
+            bool restoreSnapshot(const InterfacesSnapshotPtr& snapshot) {
+                SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+                CfgIfacePtr cfg_iface = current->getCfgIface();
+                ConstElementPtr config = snapshot->interfaces_config_;
+
+                vector<string> entries;
+                ConstElementPtr interfaces = config->get("interfaces");
+                if (interfaces) {
+                    for (auto const& el : interfaces->listValue()) {
+                        entries.push_back(el->stringValue());
+                    }
+                }
+                CfgIfaceEditor(Family::FAMILY, cfg_iface).replace(entries);
+
+                // A setting missing from the snapshot had its default value, which is taken from
+                // a default interfaces configuration.
+                CfgIface defaults;
+                bool reopen = false;
+                if (Family::HAS_SOCKET_SETTINGS) {
+                    ConstElementPtr socket_type = config->get("dhcp-socket-type");
+                    string socket_type_value = (socket_type ? socket_type->stringValue() :
+                                                defaults.socketTypeToText());
+                    if (socket_type_value != cfg_iface->socketTypeToText()) {
+                        cfg_iface->useSocketType(Family::FAMILY, socket_type_value);
+                        reopen = true;
+                    }
+                    ConstElementPtr outbound_iface = config->get("outbound-interface");
+                    cfg_iface->setOutboundIface(outbound_iface ?
+                                                CfgIface::textToOutboundIface(outbound_iface->stringValue()) :
+                                                defaults.getOutboundIface());
+                }
+                ConstElementPtr re_detect = config->get("re-detect");
+                cfg_iface->setReDetect(re_detect ? re_detect->boolValue() : defaults.getReDetect());
+                ConstElementPtr require_all = config->get("service-sockets-require-all");
+                cfg_iface->setServiceSocketsRequireAll(require_all ? require_all->boolValue() :
+                                                       defaults.getServiceSocketsRequireAll());
+                ConstElementPtr max_retries = config->get("service-sockets-max-retries");
+                cfg_iface->setServiceSocketsMaxRetries(max_retries ?
+                                                       static_cast<uint32_t>(max_retries->intValue()) :
+                                                       defaults.getServiceSocketsMaxRetries());
+                ConstElementPtr retry_wait_time = config->get("service-sockets-retry-wait-time");
+                cfg_iface->setServiceSocketsRetryWaitTime(retry_wait_time ?
+                                                          static_cast<uint32_t>(retry_wait_time->intValue()) :
+                                                          defaults.getServiceSocketsRetryWaitTime());
+                cfg_iface->setContext(config->get("user-context"));
+
+                for (auto const& subnet : *Family::getAll(current)) {
+                    string iface = snapshot->getIface(subnet->getID());
+                    if (iface != subnet->getIface(Network::Inheritance::NONE).valueOr("")) {
+                        subnet->setIface(iface);
+                    }
+                }
+
+                return (reopen);
+            }
+
+            /// @brief Returns the control socket path of the other DHCP daemon.
+            string getSiblingControlSocket() const {
+                return (sibling_control_socket_);
+            }
+
+            /// @brief Applies a change which succeeded locally to the sibling daemon.
+            ///
+            /// The command is forwarded without the 'family' argument. When the sibling rejects
+            /// the change or can not be reached, the local interfaces are restored and written
+            /// again, so both daemons either have the change or neither has it. When the command
+            /// was sent but no answer was received, the sibling may still apply it, so the local
+            /// change is kept and the result is reported as unknown.
+            ///
+            /// @param command_name Command name to forward.
+            /// @param arguments Command arguments.
+            /// @param local_answer Answer of the local change.
+            /// @param editor Editor of the local interfaces configuration.
+            /// @param saved_entries Local interfaces configured before the change.
+            ///
+            /// @return Answer with the results of both daemons.
+            ConstElementPtr applyToSibling(const string& command_name, const ConstElementPtr& arguments,
+                                           const ConstElementPtr& local_answer, CfgIfaceEditor& editor,
+                                           const vector<string>& saved_entries) {
+                string local_name = Family::name();
+                string sibling_name = Family::siblingName();
+
+                // A local failure is reported as is, the sibling is not contacted.
+                int local_rcode = CONTROL_RESULT_ERROR;
+                static_cast<void>(parseAnswer(local_rcode, local_answer));
+                if (local_rcode != CONTROL_RESULT_SUCCESS) {
+                    return (local_answer);
+                }
+
+                ElementPtr forwarded_arguments = isc::data::copy(arguments);
+                forwarded_arguments->remove("family");
+
+                ConstElementPtr sibling_answer;
+                int sibling_rcode = CONTROL_RESULT_ERROR;
+                bool indeterminate = false;
+                try {
+                    sibling_answer = sendSiblingCommand(getSiblingControlSocket(),
+                                                        createCommand(command_name, forwarded_arguments),
+                                                        SIBLING_TIMEOUT);
+                    try {
+                        static_cast<void>(parseAnswer(sibling_rcode, sibling_answer));
+                    } catch (const exception& ex) {
+                        isc_throw(SiblingIndeterminate, "invalid answer from the " << sibling_name
+                                  << " server: " << ex.what());
+                    }
+                } catch (const SiblingIndeterminate& ex) {
+                    sibling_answer = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                    sibling_rcode = CONTROL_RESULT_ERROR;
+                    indeterminate = true;
+                } catch (const exception& ex) {
+                    sibling_answer = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                    sibling_rcode = CONTROL_RESULT_ERROR;
+                }
+
+                ElementPtr results = Element::createMap();
+                results->set(sibling_name, sibling_answer);
+
+                // A timeout does not mean the sibling rejected the change, e.g. when both servers
+                // forward a change at the same time each one waits for the other, and applies the
+                // forwarded command once the wait is over. Reverting here would leave the servers
+                // apart, so the local change is kept.
+                if (indeterminate) {
+                    results->set(local_name, local_answer);
+                    LOG_WARN(interfaces_cmds_logger, INTERFACES_CMDS_SIBLING_UNKNOWN)
+                    .arg(sibling_name)
+                    .arg(sibling_answer->str());
+                    return (createAnswer(CONTROL_RESULT_ERROR, "Configuration updated on the " + local_name +
+                                         " server, the result on the " + sibling_name +
+                                         " server is unknown, check it with get-interfaces.", results));
+                }
+
+                if (sibling_rcode == CONTROL_RESULT_SUCCESS) {
+                    results->set(local_name, local_answer);
+                    return (createAnswer(CONTROL_RESULT_SUCCESS,
+                                         "Configuration updated successfully on both servers.", results));
+                }
+
+                editor.replace(saved_entries);
+                results->set(local_name, this->writeConfiguration());
+                LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SIBLING_FAILED)
+                .arg(sibling_name)
+                .arg(sibling_answer->str());
+                return (createAnswer(CONTROL_RESULT_ERROR, "Configuration not updated, " + sibling_name +
+                                     " server failed to apply the change.", results));
+            }
+
+            /// @brief Creates the traffic entry of an interface and publishes it to the statistics.
+            ///
+            /// @param iface Interface name.
+            /// @param totals Packets and bytes received on the interface.
+            ElementPtr createTrafficEntry(const string& iface, const PacketCounters::Totals& totals) {
+                int64_t packets = static_cast<int64_t>(totals.packets);
+                int64_t bytes = static_cast<int64_t>(totals.bytes);
+
+                StatsMgr::instance().setValue("interface[" + iface + "].packets-received", packets);
+                StatsMgr::instance().setValue("interface[" + iface + "].bytes-received", bytes);
+
+                ElementPtr entry = Element::createMap();
+                entry->set("interface", Element::create(iface));
+                entry->set("packets-received", Element::create(packets));
+                entry->set("bytes-received", Element::create(bytes));
+                return (entry);
+            }
+
+            /// @brief Checks the arguments of the 'set-interfaces-settings' command.
+            ///
+            /// Values are checked by applying them to a scratch interfaces configuration, so the
+            /// same rules as for the configuration file are enforced.
+            ///
+            /// @param arguments Command arguments to be parsed and validated.
+            void validateSettings(const ConstElementPtr& arguments) {
+                INTERFACES_CMDS_TRACE_SPAN("validate-arguments");
+                if (arguments->getType() != Element::map || arguments->empty()) {
+                    isc_throw(BadValue, "no settings specified for the 'set-interfaces-settings' command");
+                }
+
+                CfgIface staged;
+                for (auto const& entry : arguments->mapValue()) {
+                    const string& name = entry.first;
+                    const ConstElementPtr& value = entry.second;
+
+                    if (name == "dhcp-socket-type" || name == "outbound-interface") {
+                        if (!Family::HAS_SOCKET_SETTINGS) {
+                            isc_throw(BadValue, "'" << name << "' is supported by the DHCPv4 server only");
+                        }
+                        if (value->getType() != Element::string) {
+                            isc_throw(BadValue, "'" << name << "' argument specified for the "
+                            "'set-interfaces-settings' command is not a string");
+                        }
+                        if (name == "dhcp-socket-type") {
+                            staged.useSocketType(Family::FAMILY, value->stringValue());
+                        } else {
+                            staged.setOutboundIface(CfgIface::textToOutboundIface(value->stringValue()));
+                        }
+
+                    } else if (name == "re-detect") {
+                        if (value->getType() != Element::boolean) {
+                            isc_throw(BadValue, "'" << name << "' argument specified for the "
+                            "'set-interfaces-settings' command is not a boolean");
+                        }
+
+                    } else if (name == "service-sockets-max-retries" ||
+                               name == "service-sockets-retry-wait-time") {
+                        if (value->getType() != Element::integer || value->intValue() < 0 ||
+                            value->intValue() > numeric_limits<uint32_t>::max()) {
+                            isc_throw(BadValue, "'" << name << "' argument specified for the "
+                            "'set-interfaces-settings' command is not a unsigned 32-bit integer");
+                        }
+
+                    } else {
+                        isc_throw(BadValue, "unsupported setting '" << name
+                        << "' for the 'set-interfaces-settings' command. Expected \"dhcp-socket-type\", "
+                        "\"outbound-interface\", \"re-detect\", \"service-sockets-max-retries\", "
+                        "\"service-sockets-retry-wait-time\"");
+                    }
+                }
+
+                // The wait time is used, and written to the configuration file, only when the
+                // sockets opening is retried.
+                if (arguments->get("service-sockets-retry-wait-time")) {
+                    ConstElementPtr max_retries = arguments->get("service-sockets-max-retries");
+                    int64_t retries = (max_retries ? max_retries->intValue() :
+                                       CfgMgr::instance().getCurrentCfg()->getCfgIface()->getServiceSocketsMaxRetries());
+                    if (retries == 0) {
+                        isc_throw(BadValue, "'service-sockets-retry-wait-time' argument specified for the "
+                        "'set-interfaces-settings' command requires 'service-sockets-max-retries' "
+                        "greater than 0");
+                    }
+                }
+            }
+
+            /// @brief Reopens the DHCP sockets according to the current interfaces configuration.
+            ///
+            /// Packet processing is paused while the sockets are replaced.
+            void reopenSockets() {
+                uint16_t port = server_port;
+                if (port == 0) {
+                    port = Family::SERVER_PORT;
+                }
+
+                MultiThreadingCriticalSection cs;
+                CfgIfacePtr cfg_iface = CfgMgr::instance().getCurrentCfg()->getCfgIface();
+                cfg_iface->closeSockets();
+                cfg_iface->openSockets(Family::FAMILY, port);
+                LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_SOCKETS_REOPENED).arg(port);
+            }
+
+            /// @brief Returns interfaces of all subnets matching a user-context selector.
+            ///
+            /// Only interfaces set on the subnets themselves are reported, not the ones inherited
+            /// from a shared network.
+            ///
+            /// @param selector Map of user-context keys and values the subnets must carry.
+            ConstElementPtr getTaggedInterfaces(const ConstElementPtr& selector) {
+                vector<SubnetID> ids = SubnetTagIndex::find<Family>(selector);
+                SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+
+                ElementPtr subnets = Element::createList();
+                ElementPtr interfaces = Element::createList();
+                set<string> unique_interfaces;
+                for (auto const& id : ids) {
+                    string iface =
+                    Family::getSubnet(current, id)->getIface(Network::Inheritance::NONE).valueOr("");
+
+                    ElementPtr entry = Element::createMap();
+                    entry->set("subnet_id", Element::create(static_cast<int64_t>(id)));
+                    entry->set("interface", Element::create(iface));
+                    subnets->add(entry);
+
+                    if (!iface.empty() && unique_interfaces.insert(iface).second) {
+                        interfaces->add(Element::create(iface));
+                    }
+                }
+
+                ElementPtr map = Element::createMap();
+                map->set("interfaces", interfaces);
+                map->set("subnets", subnets);
+
+                ostringstream text;
+                text << "in section subnet " << ids.size() << " subnets matched, "
+                << interfaces->size() << " interfaces found.";
+                if (ids.empty()) {
+                    return (createAnswer(CONTROL_RESULT_EMPTY, text.str(), map));
+                }
+                return (createAnswer(CONTROL_RESULT_SUCCESS, text.str(), map));
+            }
+
+            /// @brief Sets an interface on all subnets matching a user-context selector.
+            ///
+            /// The configuration is written once for the whole matched set.
+            ///
+            /// @param selector Map of user-context keys and values the subnets must carry.
+            /// @param iface Interface name to set.
+            ConstElementPtr appendTaggedInterface(const ConstElementPtr& selector, const string& iface) {
+                vector<SubnetID> ids = SubnetTagIndex::find<Family>(selector);
+                if (ids.empty()) {
+                    return (createAnswer(CONTROL_RESULT_ERROR,
+                                         "no subnets match the 'user-context' selector " + selector->str()));
+                }
+
+                SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+                for (auto const& id : ids) {
+                    Family::getSubnet(current, id)->setIface(iface);
+                }
+
+                return (this->writeConfiguration());
+            }
+
+            /// @brief Removes an interface from all subnets matching a user-context selector.
+            ///
+            /// Matched subnets using another interface, or inheriting it from a shared network,
+            /// are left untouched. The configuration is written once for the whole matched set.
+            ///
+            /// @param selector Map of user-context keys and values the subnets must carry.
+            /// @param iface Interface name to remove.
+            ConstElementPtr deleteTaggedInterface(const ConstElementPtr& selector, const string& iface) {
+                vector<SubnetID> ids = SubnetTagIndex::find<Family>(selector);
+                if (ids.empty()) {
+                    return (createAnswer(CONTROL_RESULT_ERROR,
+                                         "no subnets match the 'user-context' selector " + selector->str()));
+                }
+
+                SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+                size_t deleted = 0;
+                for (auto const& id : ids) {
+                    typename Family::SubnetPtr subnet = Family::getSubnet(current, id);
+                    if (iface == subnet->getIface(Network::Inheritance::NONE).valueOr("")) {
+                        subnet->setIface("");
+                        ++deleted;
+                    }
+                }
+
+                if (deleted == 0) {
+                    ostringstream text;
+                    text << "interface " << iface << " not found in " << ids.size()
+                    << " subnets matching the 'user-context' selector.";
+                    return (createAnswer(CONTROL_RESULT_ERROR, text.str()));
+                }
+
+                return (this->writeConfiguration());
+            }
+
         public:
             /// @brief Processes and returns a response to 'available-interfaces' command.
             ///
             /// @param callout_handle Reference to the callout handle holding command
             /// to be processed and where result should be stored.
-            void getAvailableInterfaces(CalloutHandle& handle) {
+            virtual void getAvailableInterfaces(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("available-interfaces");
                 ConstElementPtr response;
 
                 try {
@@ -178,30 +678,55 @@ namespace isc {
                     ElementPtr ifaces = Element::createList();
                     ElementPtr ifaces_with_ip = Element::createList();
 
+                    // Packet counters of all threads are summed once per call and published to
+                    // the statistics together with the response.
+                    ElementPtr ifaces_traffic = Element::createList();
+                    std::map<unsigned int, PacketCounters::Totals> traffic = PacketCounters::collect();
+
+                    // The "name/address" entries are composed in one buffer, so its capacity is
+                    // reused by every entry instead of allocating the intermediate strings of each
+                    // concatenation. Room for an interface name and an IPv6 address is reserved.
+                    string entry;
+                    entry.reserve(64);
+
                     for (auto& el : IfaceMgr::instance().getIfaces()) {
                         string iface = el->getName();
                         ifaces->add(Element::create(iface));
 
+                        PacketCounters::Totals totals = { 0, 0 };
+                        if (el->getIndex() > 0 && el->getIndex() <= PacketCounters::MAX_IFINDEX) {
+                            auto found = traffic.find(el->getIndex());
+                            if (found != traffic.end()) {
+                                totals = found->second;
+                            }
+                        }
+                        ifaces_traffic->add(createTrafficEntry(iface, totals));
+
+                        // The addresses are taken from the interface itself, so they need no further
+                        // ownership check. If the user requested network interfaces for v4 or v6, we
+                        // display only them.
                         for (auto& el_ip : el->getAddresses()) {
-                            // Determine which addresses belong to a specific network interface.
-                            if (el->hasAddress(el_ip)) {
-                                // If the user requested network interfaces for v4 or v6, we display only
-                                // them.
-                                if (family_ == AF_INET && el_ip.get().isV4()) {
-                                    ifaces_with_ip->add(
-                                        Element::create(iface + "/" + el_ip.get().toText()));
-                                } else if (family_ == AF_INET6 && el_ip.get().isV6()) {
-                                    ifaces_with_ip->add(
-                                        Element::create(iface + "/" + el_ip.get().toText()));
-                                }
+                            const IOAddress& address = el_ip.get();
+                            if (Family::isFamilyAddress(address)) {
+                                entry.assign(iface);
+                                entry.push_back('/');
+                                entry.append(address.toText());
+                                ifaces_with_ip->add(Element::create(entry));
                             }
-                        };
-                    };
+                        }
+                    }
+
+                    // Interfaces with an index out of the counters range are reported together.
+                    auto other = traffic.find(0);
+                    if (other != traffic.end()) {
+                        ifaces_traffic->add(createTrafficEntry("other", other->second));
+                    }
 
                     // We assemble the final object that the client will receive.
                     ElementPtr map = Element::createMap();
                     map->set("interfaces", ifaces);
                     map->set("interfaces-with-ip", ifaces_with_ip);
+                    map->set("interfaces-traffic", ifaces_traffic);
 
                     ostringstream text;
                     text << ifaces->size() << " interfaces found.";
@@ -224,7 +749,8 @@ namespace isc {
             ///
             /// @param callout_handle Reference to the callout handle holding command
             /// to be processed and where result should be stored.
-            void getInterfaces(CalloutHandle& handle) {
+            virtual void getInterfaces(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("get-interfaces");
                 ConstElementPtr response;
                 ElementPtr map = Element::createMap();
 
@@ -259,31 +785,34 @@ namespace isc {
                         }
 
                     } else if (section == "subnet") {
+                        // Subnets selected by their user-context are served from the tag index.
+                        ConstElementPtr selector = arguments->get("user-context");
+                        if (selector) {
+                            response = getTaggedInterfaces(selector);
+                            LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_INTERFACES_GET);
+                            handle.setArgument("response", response);
+                            return;
+                        }
+
                         // If the user requested an interface from a subnet, we first get its ID.
                         int subnet_id = arguments->get("subnet_id")->intValue();
 
-                        // We will predefine a pointer for the network interface, and then search through
-                        // the subnet configuration to find the required element.
-                        ConstElementPtr interface = nullptr;
-                        if (family_ == AF_INET) {
-                            Subnet4Ptr subnet4_config =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getSubnet(
-                                SubnetID(subnet_id));
-                            if (subnet4_config) {
-                                interface = subnet4_config->toElement()->get("interface");
-                            }
-                        } else {
-                            Subnet6Ptr subnet6_config =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getSubnet(
-                                SubnetID(subnet_id));
-                            if (subnet6_config) {
-                                interface = subnet6_config->toElement()->get("interface");
+                        // The interface is read directly from the subnet, serializing the whole subnet
+                        // with its pools and options just to pick one value is avoided. As with the
+                        // serialized subnet, an interface inherited from a shared network is not reported.
+                        string interface;
+                        {
+                            INTERFACES_CMDS_TRACE_SPAN("cfgmgr-lookup");
+                            typename Family::SubnetPtr subnet =
+                            Family::getSubnet(CfgMgr::instance().getCurrentCfg(), SubnetID(subnet_id));
+                            if (subnet) {
+                                interface = subnet->getIface(Network::Inheritance::NONE).valueOr("");
                             }
                         }
 
                         // If the network interface is not found, we return the result to the user with a
                         // status corresponding to an empty value.
-                        if (!interface) {
+                        if (interface.empty()) {
                             ostringstream text;
                             text << "in section " << section << " with id " << subnet_id
                             << " not setted interface.";
@@ -300,7 +829,7 @@ namespace isc {
                         // interface name in it. To maintain compatibility with the global section, a list
                         // is always returned to the user.
                         ElementPtr list = Element::createList();
-                        list->add(Element::create(interface->stringValue()));
+                        list->add(Element::create(interface));
                         map->set("interfaces", list);
                         ostringstream text;
                         text << "in section " << section << " with id " << subnet_id << " interface found.";
@@ -321,7 +850,8 @@ namespace isc {
             ///
             /// @param callout_handle Reference to the callout handle holding command
             /// to be processed and where result should be stored.
-            void appendInterfaces(CalloutHandle& handle) {
+            virtual void appendInterfaces(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("append-interfaces");
                 ConstElementPtr response;
                 ElementPtr map = Element::createMap();
 
@@ -330,6 +860,12 @@ namespace isc {
                     ConstElementPtr arguments = getMandatoryArguments(handle);
                     validateArguments("append-interfaces", arguments);
 
+                    // Record the state before the change, so it can be rolled back to.
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("snapshot-capture");
+                        InterfacesSnapshots::capture<Family>();
+                    }
+
                     string section = arguments->get("section")->stringValue();
                     vector<ElementPtr> new_interfaces = arguments->get("interfaces")->listValue();
 
@@ -337,30 +873,45 @@ namespace isc {
                     // If the user wants to add addresses in the global section, we will set them up first
                     // through a loop, and then write the configuration to disk.
                     if (section == "global") {
-                        for (auto& el : new_interfaces) {
-                            string iface = el->stringValue();
-                            config_interfaces->use(family_, iface);
+                        // The interfaces are added all or none, a rejected one restores the entries
+                        // which were configured before.
+                        CfgIfaceEditor editor(Family::FAMILY, config_interfaces);
+                        vector<string> saved_entries = editor.getEntries();
+                        try {
+                            for (auto& el : new_interfaces) {
+                                string iface = el->stringValue();
+                                config_interfaces->use(Family::FAMILY, iface);
+                            }
+                        } catch (const exception&) {
+                            editor.replace(saved_entries);
+                            throw;
                         }
 
                         response = this->writeConfiguration();
+
+                        // In dual-stack mode the same change is then applied by the sibling daemon.
+                        if (arguments->get("family")) {
+                            response = applyToSibling("append-interfaces", arguments, response,
+                                                      editor, saved_entries);
+                        }
                     } else if (section == "subnet") {
+                        // All subnets matching the user-context selector are updated at once.
+                        ConstElementPtr selector = arguments->get("user-context");
+                        if (selector) {
+                            response = appendTaggedInterface(selector, new_interfaces[0]->stringValue());
+                            handle.setArgument("response", response);
+                            return;
+                        }
+
                         // If the user wishes to set a subnet address, we obtain the subnet ID and the first
                         // element of the array of addresses that he passed for setting.
                         int subnet_id = arguments->get("subnet_id")->intValue();
 
                         bool is_found_subnet = false;
-                        if (family_ == AF_INET) {
-                            Subnet4Ptr subnet =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getSubnet(
-                                SubnetID(subnet_id));
-                            if (subnet) {
-                                is_found_subnet = true;
-                                subnet->setIface(new_interfaces[0]->stringValue());
-                            }
-                        } else {
-                            Subnet6Ptr subnet =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getSubnet(
-                                SubnetID(subnet_id));
+                        {
+                            INTERFACES_CMDS_TRACE_SPAN("cfgmgr-lookup");
+                            typename Family::SubnetPtr subnet =
+                            Family::getSubnet(CfgMgr::instance().getCurrentCfg(), SubnetID(subnet_id));
                             if (subnet) {
                                 is_found_subnet = true;
                                 subnet->setIface(new_interfaces[0]->stringValue());
@@ -392,7 +943,8 @@ namespace isc {
             ///
             /// @param callout_handle Reference to the callout handle holding command
             /// to be processed and where result should be stored.
-            void deleteInterfaces(CalloutHandle& handle) {
+            virtual void deleteInterfaces(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("delete-interfaces");
                 ConstElementPtr response;
                 ElementPtr map = Element::createMap();
 
@@ -401,73 +953,75 @@ namespace isc {
                     ConstElementPtr arguments = getMandatoryArguments(handle);
                     validateArguments("delete-interfaces", arguments);
 
-                    // First, let's define all the parameters that need to be worked with. The section from
-                    // which interfaces are removed, the list of current interfaces in the global
-                    // configuration, and the user-specified interfaces to remove.
-                    string section = arguments->get("section")->stringValue();
-                    ConstElementPtr interfaces_map =
-                    CfgMgr::instance().getCurrentCfg()->getCfgIface()->toElement();
-                    vector<ElementPtr> current_interfaces = interfaces_map->get("interfaces")->listValue();
-                    vector<ElementPtr> delete_interfaces = arguments->get("interfaces")->listValue();
+                    // Record the state before the change, so it can be rolled back to.
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("snapshot-capture");
+                        InterfacesSnapshots::capture<Family>();
+                    }
 
-                    CfgMgr::instance().getCurrentCfg()->getCfgIface()->reset();
-                    CfgIfacePtr interfaces_config = CfgMgr::instance().getCurrentCfg()->getCfgIface();
+                    // The section from which interfaces are removed. Only the global section touches
+                    // the interfaces configuration, subnet deletions leave it as it is.
+                    string section = arguments->get("section")->stringValue();
 
                     if (section == "global") {
-                        // Since there is no function to delete a specific interface in the configuration
-                        // manager API, we clear all interfaces and add only those that were previously
-                        // created and not specified by the user for deletion.
-                        for (auto& el : current_interfaces) {
-                            string iface = el->stringValue();
-
-                            bool is_found = false;
-                            for (auto& delete_el : delete_interfaces) {
-                                string delete_iface = delete_el->stringValue();
-                                if (iface == delete_iface) {
-                                    is_found = true;
-                                }
-                            }
+                        vector<string> delete_interfaces;
+                        for (auto& el : arguments->get("interfaces")->listValue()) {
+                            delete_interfaces.push_back(el->stringValue());
+                        }
 
-                            if (is_found) {
-                                continue;
-                            }
+                        // The editor applies only the real difference to the configuration and keeps
+                        // unicast addresses and the other interfaces-config settings.
+                        CfgIfaceEditor editor(Family::FAMILY, CfgMgr::instance().getCurrentCfg()->getCfgIface());
+                        vector<string> saved_entries = editor.getEntries();
+                        vector<string> missing = editor.remove(delete_interfaces);
 
-                            // If the interface is not specified by the user for deletion, we return it to
-                            // the configuration.
-                            interfaces_config->use(family_, iface);
+                        // If any interface is not configured, we inform the user about this and take
+                        // no action.
+                        if (!missing.empty()) {
+                            ostringstream text;
+                            text << "interfaces";
+                            for (auto const& iface : missing) {
+                                text << " " << iface;
+                            }
+                            text << " in section " << section << " not found.";
+                            response = createAnswer(CONTROL_RESULT_ERROR, text.str(), map);
+                        } else {
+                            response = this->writeConfiguration();
                         }
 
-                        response = this->writeConfiguration();
+                        // In dual-stack mode the same change is then applied by the sibling daemon.
+                        if (arguments->get("family")) {
+                            response = applyToSibling("delete-interfaces", arguments, response,
+                                                      editor, saved_entries);
+                        }
 
                     } else if (section == "subnet") {
+                        string delete_interface =
+                        arguments->get("interfaces")->listValue()[0]->stringValue();
+
+                        // All subnets matching the user-context selector are updated at once.
+                        ConstElementPtr selector = arguments->get("user-context");
+                        if (selector) {
+                            response = deleteTaggedInterface(selector, delete_interface);
+                            handle.setArgument("response", response);
+                            return;
+                        }
+
                         // In subnets, we first obtain the subnet ID to be deleted and the interface itself
                         // that the user wants to delete.
                         int subnet_id = arguments->get("subnet_id")->intValue();
-                        string delete_interface =
-                        arguments->get("interfaces")->listValue()[0]->stringValue();
 
                         // Two flags determine whether the user-specified subnet exists and whether the
                         // address they specify to delete exists on the subnet.
                         bool is_found_subnet = false;
                         bool is_found_interface = false;
-                        if (family_ == AF_INET) {
-                            Subnet4Ptr subnet =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getSubnet(
-                                SubnetID(subnet_id));
-                            if (subnet) {
-                                is_found_subnet = true;
-                                if (delete_interface == subnet->getIface().valueOr("")) {
-                                    is_found_interface = true;
-                                    subnet->setIface("");
-                                }
-                            }
-                        } else {
-                            Subnet6Ptr subnet =
-                            CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getSubnet(
-                                SubnetID(subnet_id));
+                        {
+                            INTERFACES_CMDS_TRACE_SPAN("cfgmgr-lookup");
+                            typename Family::SubnetPtr subnet =
+                            Family::getSubnet(CfgMgr::instance().getCurrentCfg(), SubnetID(subnet_id));
                             if (subnet) {
                                 is_found_subnet = true;
-                                if (delete_interface == subnet->getIface().valueOr("")) {
+                                if (delete_interface == subnet->getIface(Network::Inheritance::NONE).valueOr("")) {
                                     is_found_interface = true;
                                     subnet->setIface("");
                                 }
@@ -500,12 +1054,316 @@ namespace isc {
                 handle.setArgument("response", response);
             }
 
+            /// @brief Processes and returns a response to 'get-interfaces-settings' command.
+            ///
+            /// @param callout_handle Reference to the callout handle holding command
+            /// to be processed and where result should be stored.
+            virtual void getInterfacesSettings(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("get-interfaces-settings");
+                ConstElementPtr response;
+
+                try {
+                    CfgIfacePtr cfg_iface = CfgMgr::instance().getCurrentCfg()->getCfgIface();
+
+                    ElementPtr map = Element::createMap();
+                    if (Family::HAS_SOCKET_SETTINGS) {
+                        map->set("dhcp-socket-type", Element::create(cfg_iface->socketTypeToText()));
+                        map->set("outbound-interface", Element::create(cfg_iface->outboundTypeToText()));
+                    }
+                    map->set("re-detect", Element::create(cfg_iface->getReDetect()));
+                    map->set("service-sockets-max-retries",
+                             Element::create(static_cast<int64_t>(cfg_iface->getServiceSocketsMaxRetries())));
+                    map->set("service-sockets-retry-wait-time",
+                             Element::create(static_cast<int64_t>(cfg_iface->getServiceSocketsRetryWaitTime())));
+
+                    response = createAnswer(CONTROL_RESULT_SUCCESS, "interfaces settings returned.", map);
+                    LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_GET);
+
+                } catch (const exception& ex) {
+                    LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED)
+                    .arg(ex.what());
+
+                    response = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                }
+
+                handle.setArgument("response", response);
+            }
+
+            /// @brief Processes and returns a response to 'set-interfaces-settings' command.
+            ///
+            /// The sockets are reopened when the socket type changes. Other settings are
+            /// used by the server on the next sockets opening or interfaces detection.
+            ///
+            /// @param callout_handle Reference to the callout handle holding command
+            /// to be processed and where result should be stored.
+            virtual void setInterfacesSettings(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("set-interfaces-settings");
+                ConstElementPtr response;
+
+                try {
+                    // Validate all settings before changing any of them.
+                    ConstElementPtr arguments = getMandatoryArguments(handle);
+                    validateSettings(arguments);
+
+                    // Record the state before the change, so it can be rolled back to.
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("snapshot-capture");
+                        InterfacesSnapshots::capture<Family>();
+                    }
+
+                    CfgIfacePtr cfg_iface = CfgMgr::instance().getCurrentCfg()->getCfgIface();
+                    bool reopen = false;
+
+                    // The previous settings are restored when the sockets cannot be reopened.
+                    string previous_socket_type = cfg_iface->socketTypeToText();
+                    CfgIface::OutboundIface previous_outbound_iface = cfg_iface->getOutboundIface();
+                    bool previous_re_detect = cfg_iface->getReDetect();
+                    uint32_t previous_max_retries = cfg_iface->getServiceSocketsMaxRetries();
+                    uint32_t previous_retry_wait_time = cfg_iface->getServiceSocketsRetryWaitTime();
+
+                    ConstElementPtr socket_type = arguments->get("dhcp-socket-type");
+                    if (socket_type && socket_type->stringValue() != cfg_iface->socketTypeToText()) {
+                        cfg_iface->useSocketType(Family::FAMILY, socket_type->stringValue());
+                        reopen = true;
+                    }
+
+                    ConstElementPtr outbound_iface = arguments->get("outbound-interface");
+                    if (outbound_iface) {
+                        cfg_iface->setOutboundIface(CfgIface::textToOutboundIface(outbound_iface->stringValue()));
+                    }
+
+                    ConstElementPtr re_detect = arguments->get("re-detect");
+                    if (re_detect) {
+                        cfg_iface->setReDetect(re_detect->boolValue());
+                    }
+
+                    ConstElementPtr max_retries = arguments->get("service-sockets-max-retries");
+                    if (max_retries) {
+                        cfg_iface->setServiceSocketsMaxRetries(static_cast<uint32_t>(max_retries->intValue()));
+                    }
+
+                    ConstElementPtr retry_wait_time = arguments->get("service-sockets-retry-wait-time");
+                    if (retry_wait_time) {
+                        cfg_iface->setServiceSocketsRetryWaitTime(
+                            static_cast<uint32_t>(retry_wait_time->intValue()));
+                    }
+
+                    if (reopen) {
+                        try {
+                            reopenSockets();
+                        } catch (const exception& ex) {
+                            if (Family::HAS_SOCKET_SETTINGS) {
+                                cfg_iface->useSocketType(Family::FAMILY, previous_socket_type);
+                                cfg_iface->setOutboundIface(previous_outbound_iface);
+                            }
+                            cfg_iface->setReDetect(previous_re_detect);
+                            cfg_iface->setServiceSocketsMaxRetries(previous_max_retries);
+                            cfg_iface->setServiceSocketsRetryWaitTime(previous_retry_wait_time);
+
+                            ostringstream text;
+                            text << "failed to reopen the sockets: " << ex.what() << ", previous settings restored";
+                            try {
+                                reopenSockets();
+                            } catch (const exception& restore_ex) {
+                                text << ", reopening the previous sockets failed: " << restore_ex.what();
+                            }
+                            isc_throw(Unexpected, text.str());
+                        }
+                    }
+
+                    response = this->writeConfiguration();
+                    LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_SET);
+
+                } catch (const exception& ex) {
+                    LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED)
+                    .arg(ex.what());
+
+                    response = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                }
+
+                handle.setArgument("response", response);
+            }
+
+            /// @brief Processes and returns a response to 'get-interfaces-snapshots' command.
+            ///
+            /// @param callout_handle Reference to the callout handle holding command
+            /// to be processed and where result should be stored.
+            virtual void getInterfacesSnapshots(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("get-interfaces-snapshots");
+                ConstElementPtr response;
+
+                try {
+                    ElementPtr list = Element::createList();
+                    for (auto const& snapshot : InterfacesSnapshots::getAll()) {
+                        size_t subnets = 0;
+                        for (auto const& chunk : snapshot->chunks_) {
+                            subnets += chunk.second->entries_.size();
+                        }
+
+                        ElementPtr entry = Element::createMap();
+                        entry->set("snapshot-id", Element::create(static_cast<int64_t>(snapshot->id_)));
+                        entry->set("timestamp", Element::create(static_cast<int64_t>(snapshot->timestamp_)));
+                        ConstElementPtr interfaces = snapshot->interfaces_config_->get("interfaces");
+                        entry->set("interfaces", interfaces ? isc::data::copy(interfaces) : Element::createList());
+                        entry->set("subnets-with-interface", Element::create(static_cast<int64_t>(subnets)));
+                        list->add(entry);
+                    }
+
+                    ElementPtr map = Element::createMap();
+                    map->set("snapshots", list);
+
+                    ostringstream text;
+                    text << list->size() << " snapshots found.";
+                    response = createAnswer(list->empty() ? CONTROL_RESULT_EMPTY : CONTROL_RESULT_SUCCESS,
+                                            text.str(), map);
+                    LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_SNAPSHOTS_GET);
+
+                } catch (const exception& ex) {
+                    LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED)
+                    .arg(ex.what());
+
+                    response = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                }
+
+                handle.setArgument("response", response);
+            }
+
+            /// @brief Processes and returns a response to 'interfaces-rollback' command.
+            ///
+            /// Without the 'snapshot-id' argument the configuration preceding the current one is
+            /// restored.
+            ///
+            /// @param callout_handle Reference to the callout handle holding command
+            /// to be processed and where result should be stored.
+            virtual void rollbackInterfaces(CalloutHandle& handle) {
+                INTERFACES_CMDS_TRACE_SPAN("interfaces-rollback");
+                ConstElementPtr response;
+
+                try {
+                    // Arguments are optional for this command.
+                    ConstElementPtr command;
+                    handle.getArgument("command", command);
+                    ConstElementPtr arguments;
+                    static_cast<void>(parseCommand(arguments, command));
+
+                    // A requested snapshot is resolved before the current state is captured, the
+                    // capture may drop the oldest snapshot when the configuration has changed.
+                    InterfacesSnapshotPtr target;
+                    ConstElementPtr snapshot_id = (arguments ? arguments->get("snapshot-id") : ConstElementPtr());
+                    if (snapshot_id) {
+                        if (snapshot_id->getType() != Element::integer) {
+                            isc_throw(BadValue, "'snapshot-id' argument specified for the "
+                            "'interfaces-rollback' command is not a unsigned integer");
+                        }
+                        target = InterfacesSnapshots::get(snapshot_id->intValue());
+                        if (!target) {
+                            isc_throw(BadValue, "snapshot with id " << snapshot_id->intValue() << " not found.");
+                        }
+                    }
+
+                    // The current state is recorded, so the rollback itself can be undone.
+                    InterfacesSnapshotPtr current;
+                    {
+                        INTERFACES_CMDS_TRACE_SPAN("snapshot-capture");
+                        current = InterfacesSnapshots::capture<Family>();
+                    }
+
+                    // By default the snapshot preceding the current state is restored.
+                    if (!target) {
+                        vector<InterfacesSnapshotPtr> all = InterfacesSnapshots::getAll();
+                        if (all.size() < 2) {
+                            isc_throw(BadValue, "no previous snapshot to roll back to.");
+                        }
+                        target = all[all.size() - 2];
+                    }
+
+                    if (target == current) {
+                        ostringstream text;
+                        text << "snapshot with id " << target->id_ << " is the current configuration.";
+                        response = createAnswer(CONTROL_RESULT_EMPTY, text.str());
+                    } else {
+                        applySnapshot(target, current);
+                        response = this->writeConfiguration();
+                        LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_ROLLBACK).arg(target->id_);
+                    }
+
+                } catch (const exception& ex) {
+                    LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED)
+                    .arg(ex.what());
+
+                    response = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                }
+
+                handle.setArgument("response", response);
+            }
+
+#if defined(INTERFACES_CMDS_TRACING)
+            /// @brief Processes and returns a response to 'interfaces-trace-dump' command.
+            ///
+            /// Returns the recorded spans as Chrome trace-event JSON. The spans are dropped when
+            /// the optional 'clear' argument is true.
+            ///
+            /// @param callout_handle Reference to the callout handle holding command
+            /// to be processed and where result should be stored.
+            virtual void dumpTrace(CalloutHandle& handle) {
+                ConstElementPtr response;
+
+                try {
+                    // Arguments are optional for this command.
+                    ConstElementPtr command;
+                    handle.getArgument("command", command);
+                    ConstElementPtr arguments;
+                    static_cast<void>(parseCommand(arguments, command));
+
+                    bool clear = false;
+                    ConstElementPtr clear_arg = (arguments ? arguments->get("clear") : ConstElementPtr());
+                    if (clear_arg) {
+                        if (clear_arg->getType() != Element::boolean) {
+                            isc_throw(BadValue, "'clear' argument specified for the "
+                            "'interfaces-trace-dump' command is not a boolean");
+                        }
+                        clear = clear_arg->boolValue();
+                    }
+
+                    ElementPtr document = TraceBuffer::dump(clear);
+                    ostringstream text;
+                    text << document->get("traceEvents")->size() << " trace events found.";
+                    response = createAnswer(CONTROL_RESULT_SUCCESS, text.str(), document);
+
+                } catch (const exception& ex) {
+                    LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED)
+                    .arg(ex.what());
+
+                    response = createAnswer(CONTROL_RESULT_ERROR, ex.what());
+                }
+
+                handle.setArgument("response", response);
+            }
+#endif
+
         private:
-            /// @brief Protocol family (IPv4 or IPv6)
-            uint16_t family_;
+            /// @brief Configuration file of the server.
+            string config_path_;
+
+            /// @brief Control socket of the other DHCP daemon, empty if not set.
+            string sibling_control_socket_;
         };
 
-        InterfacesCmds::InterfacesCmds() : impl_(new InterfacesCmdsImpl()) {
+        void
+        createImplementation(uint16_t family) {
+            if (family == AF_INET) {
+                implementation.reset(new InterfacesCmdsFamilyImpl<Family4>(dhcp4_config_path,
+                                                                           dhcp6_control_socket));
+            } else {
+                implementation.reset(new InterfacesCmdsFamilyImpl<Family6>(dhcp6_config_path,
+                                                                           dhcp4_control_socket));
+            }
+        }
+
+        InterfacesCmds::InterfacesCmds() : impl_(implementation) {
+            if (!impl_) {
+                isc_throw(InvalidOperation, "interfaces commands are not initialized");
+            }
         }
 
         void
@@ -528,5 +1386,32 @@ namespace isc {
             impl_->deleteInterfaces(handle);
         }
 
+        void
+        InterfacesCmds::getInterfacesSettings(CalloutHandle& handle) const {
+            impl_->getInterfacesSettings(handle);
+        }
+
+        void
+        InterfacesCmds::setInterfacesSettings(CalloutHandle& handle) {
+            impl_->setInterfacesSettings(handle);
+        }
+
+        void
+        InterfacesCmds::getInterfacesSnapshots(CalloutHandle& handle) const {
+            impl_->getInterfacesSnapshots(handle);
+        }
+
+        void
+        InterfacesCmds::rollbackInterfaces(CalloutHandle& handle) {
+            impl_->rollbackInterfaces(handle);
+        }
+
+#if defined(INTERFACES_CMDS_TRACING)
+        void
+        InterfacesCmds::dumpTrace(CalloutHandle& handle) const {
+            impl_->dumpTrace(handle);
+        }
+#endif
+
     }  // namespace interfaces_cmds
 }  // namespace isc
@@ -12,11 +12,17 @@ namespace interfaces_cmds {
 
 // Functions for storing and clearing user-defined parameters when the hook is activated
 void
-storeConfiguration(std::string dhcp4_config_path, std::string dhcp6_config_path);
+storeConfiguration(std::string dhcp4_config_path, std::string dhcp6_config_path,
+                   uint16_t server_port, std::string dhcp4_control_socket,
+                   std::string dhcp6_control_socket);
 
 void
 clearConfiguration();
 
+// Creates the command handlers of the server protocol family, after the parameters are stored
+void
+createImplementation(uint16_t family);
+
 /// @brief Forward declaration of implementation class.
 class InterfacesCmdsImpl;
 
@@ -24,7 +30,9 @@ class InterfacesCmds {
 public:
     /// @brief Constructor.
     ///
-    /// It creates an instance of the @c InterfacesCmdsImpl.
+    /// It uses the instance of the @c InterfacesCmdsImpl created by @c createImplementation.
+    ///
+    /// @throw InvalidOperation if the implementation is not created.
     InterfacesCmds();
 
     void getAvailableInterfaces(hooks::CalloutHandle& handle) const;
@@ -35,6 +43,18 @@ public:
 
     void deleteInterfaces(hooks::CalloutHandle& handle);
 
+    void getInterfacesSettings(hooks::CalloutHandle& handle) const;
+
+    void setInterfacesSettings(hooks::CalloutHandle& handle);
+
+    void getInterfacesSnapshots(hooks::CalloutHandle& handle) const;
+
+    void rollbackInterfaces(hooks::CalloutHandle& handle);
+
+#if defined(INTERFACES_CMDS_TRACING)
+    void dumpTrace(hooks::CalloutHandle& handle) const;
+#endif
+
 private:
     /// Pointer to the actual implementation
     boost::shared_ptr<InterfacesCmdsImpl> impl_;
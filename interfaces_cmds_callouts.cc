@@ -1,5 +1,7 @@
 #include <config.h>
 
+#include <dhcp/pkt4.h>
+#include <dhcp/pkt6.h>
 #include <dhcpsrv/cfgmgr.h>
 #include <hooks/hooks.h>
 #include <process/daemon.h>
@@ -12,6 +14,10 @@
 #include "cc/data.h"
 #include "exceptions/exceptions.h"
 #include "interfaces_cmds.h"
+#include "interfaces_cmds_counters.h"
+#include "interfaces_cmds_snapshots.h"
+#include "interfaces_cmds_trace.h"
+#include "interfaces_cmds_tag_index.h"
 #include "log/macros.h"
 #include "process/daemon.h"
 
@@ -105,6 +111,108 @@ delete_interfaces(CalloutHandle& handle) {
     return (0);
 }
 
+/// @brief This is a command callout for 'get-interfaces-settings' command.
+///
+/// @param handle Callout handle used to retrieve a command and
+/// provide a response.
+/// @return 0 if this callout has been invoked successfully,
+/// 1 otherwise.
+int
+get_interfaces_settings(CalloutHandle& handle) {
+    try {
+        InterfacesCmds instance;
+        instance.getInterfacesSettings(handle);
+    } catch (const std::exception& ex) {
+        LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED)
+            .arg(ex.what());
+        return (1);
+    }
+
+    return (0);
+}
+
+/// @brief This is a command callout for 'set-interfaces-settings' command.
+///
+/// @param handle Callout handle used to retrieve a command and
+/// provide a response.
+/// @return 0 if this callout has been invoked successfully,
+/// 1 otherwise.
+int
+set_interfaces_settings(CalloutHandle& handle) {
+    try {
+        InterfacesCmds instance;
+        instance.setInterfacesSettings(handle);
+    } catch (const std::exception& ex) {
+        LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED)
+            .arg(ex.what());
+        return (1);
+    }
+
+    return (0);
+}
+
+/// @brief This is a command callout for 'get-interfaces-snapshots' command.
+///
+/// @param handle Callout handle used to retrieve a command and
+/// provide a response.
+/// @return 0 if this callout has been invoked successfully,
+/// 1 otherwise.
+int
+get_interfaces_snapshots(CalloutHandle& handle) {
+    try {
+        InterfacesCmds instance;
+        instance.getInterfacesSnapshots(handle);
+    } catch (const std::exception& ex) {
+        LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED)
+            .arg(ex.what());
+        return (1);
+    }
+
+    return (0);
+}
+
+/// @brief This is a command callout for 'interfaces-rollback' command.
+///
+/// @param handle Callout handle used to retrieve a command and
+/// provide a response.
+/// @return 0 if this callout has been invoked successfully,
+/// 1 otherwise.
+int
+interfaces_rollback(CalloutHandle& handle) {
+    try {
+        InterfacesCmds instance;
+        instance.rollbackInterfaces(handle);
+    } catch (const std::exception& ex) {
+        LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED)
+            .arg(ex.what());
+        return (1);
+    }
+
+    return (0);
+}
+
+#if defined(INTERFACES_CMDS_TRACING)
+/// @brief This is a command callout for 'interfaces-trace-dump' command.
+///
+/// @param handle Callout handle used to retrieve a command and
+/// provide a response.
+/// @return 0 if this callout has been invoked successfully,
+/// 1 otherwise.
+int
+interfaces_trace_dump(CalloutHandle& handle) {
+    try {
+        InterfacesCmds instance;
+        instance.dumpTrace(handle);
+    } catch (const std::exception& ex) {
+        LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED)
+            .arg(ex.what());
+        return (1);
+    }
+
+    return (0);
+}
+#endif
+
 // A small helper for checking if a file exists in the file system.
 bool
 is_file_exists(const std::string& name) {
@@ -150,19 +258,75 @@ load(hooks::LibraryHandle& handle) {
         std::string dhcp4_config_path_value = dhcp4_config_path->stringValue();
         std::string dhcp6_config_path_value = dhcp6_config_path->stringValue();
 
-        storeConfiguration(dhcp4_config_path_value, dhcp6_config_path_value);
+        // The optional server port is used to reopen sockets when their type is changed,
+        // zero selects the standard port of the protocol family.
+        uint16_t server_port_value = 0;
+        ConstElementPtr server_port = handle.getParameter("server-port");
+        if (server_port) {
+            if (server_port->getType() != Element::integer || server_port->intValue() < 0 ||
+                server_port->intValue() > 65535) {
+                LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_PARAM_BAD_TYPE);
+                return (1);
+            }
+            server_port_value = static_cast<uint16_t>(server_port->intValue());
+        }
+
+        // The optional control sockets of the DHCP daemons enable the dual-stack mode, in which
+        // changes are forwarded to the sibling daemon.
+        std::string dhcp4_control_socket_value;
+        std::string dhcp6_control_socket_value;
+        ConstElementPtr dhcp4_control_socket = handle.getParameter("dhcp4-control-socket");
+        ConstElementPtr dhcp6_control_socket = handle.getParameter("dhcp6-control-socket");
+        if ((dhcp4_control_socket && dhcp4_control_socket->getType() != Element::string) ||
+            (dhcp6_control_socket && dhcp6_control_socket->getType() != Element::string)) {
+            LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_PARAM_BAD_TYPE);
+            return (1);
+        }
+        if (dhcp4_control_socket) {
+            dhcp4_control_socket_value = dhcp4_control_socket->stringValue();
+        }
+        if (dhcp6_control_socket) {
+            dhcp6_control_socket_value = dhcp6_control_socket->stringValue();
+        }
+
+        storeConfiguration(dhcp4_config_path_value, dhcp6_config_path_value, server_port_value,
+                           dhcp4_control_socket_value, dhcp6_control_socket_value);
+
+        // The optional number of interfaces configurations kept for 'interfaces-rollback', the
+        // latest one is always the current configuration so at least two are needed.
+        ConstElementPtr snapshots_depth = handle.getParameter("snapshots-depth");
+        if (snapshots_depth) {
+            if (snapshots_depth->getType() != Element::integer ||
+                snapshots_depth->intValue() < static_cast<int64_t>(InterfacesSnapshots::MIN_DEPTH)) {
+                LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_PARAM_BAD_TYPE);
+                return (1);
+            }
+            InterfacesSnapshots::setDepth(static_cast<size_t>(snapshots_depth->intValue()));
+        }
 
         if (!is_file_exists(dhcp4_config_path_value) || !is_file_exists(dhcp6_config_path_value)) {
             LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_FILE_NOT_FOUND);
             return (1);
         }
 
+        // The handlers of the server protocol family are selected once for all commands,
+        // after all parameters are validated.
+        createImplementation(family);
+
         // Registering API event handlers.
         handle.registerCommandCallout("available-interfaces", available_interfaces);
         handle.registerCommandCallout("get-interfaces", get_interfaces);
         handle.registerCommandCallout("append-interfaces", append_interfaces);
         handle.registerCommandCallout("delete-interfaces", delete_interfaces);
+        handle.registerCommandCallout("get-interfaces-settings", get_interfaces_settings);
+        handle.registerCommandCallout("set-interfaces-settings", set_interfaces_settings);
+        handle.registerCommandCallout("get-interfaces-snapshots", get_interfaces_snapshots);
+        handle.registerCommandCallout("interfaces-rollback", interfaces_rollback);
+#if defined(INTERFACES_CMDS_TRACING)
+        handle.registerCommandCallout("interfaces-trace-dump", interfaces_trace_dump);
+#endif
     } catch (const std::exception& ex) {
+        clearConfiguration();
         LOG_ERROR(interfaces_cmds_logger, INTERFACES_CMDS_INIT_FAILED).arg(ex.what());
         return (1);
     }
@@ -171,8 +335,43 @@ load(hooks::LibraryHandle& handle) {
     return (0);
 }
 
+/// @brief This callout is called at the "pkt4_receive" hook.
+///
+/// Counts the received packet on its interface.
+///
+/// @param handle CalloutHandle.
+/// @return 0 upon success, non-zero otherwise.
+int
+pkt4_receive(CalloutHandle& handle) {
+    Pkt4Ptr query;
+    handle.getArgument("query4", query);
+    PacketCounters::count(query->getIndex(), query->data_.size());
+    return (0);
+}
+
+/// @brief This callout is called at the "pkt6_receive" hook.
+///
+/// Counts the received packet on its interface.
+///
+/// @param handle CalloutHandle.
+/// @return 0 upon success, non-zero otherwise.
+int
+pkt6_receive(CalloutHandle& handle) {
+    Pkt6Ptr query;
+    handle.getArgument("query6", query);
+    PacketCounters::count(query->getIndex(), query->data_.size());
+    return (0);
+}
+
 int
 unload() {
+    clearConfiguration();
+    SubnetTagIndex::clear();
+    PacketCounters::clear();
+    InterfacesSnapshots::clear();
+#if defined(INTERFACES_CMDS_TRACING)
+    TraceBuffer::clear();
+#endif
     LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_DEINIT_OK);
     return (0);
 }
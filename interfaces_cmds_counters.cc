@@ -0,0 +1,108 @@
+#include <config.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <interfaces_cmds_counters.h>
+
+using namespace isc::interfaces_cmds;
+using namespace std;
+
+namespace {
+
+/// @brief Counters of one interface, written by a single thread.
+struct Counter {
+    atomic<uint64_t> packets;
+    atomic<uint64_t> bytes;
+};
+
+/// @brief Counters of all interfaces owned by one thread.
+///
+/// The alignment keeps blocks of different threads on distinct cache lines.
+struct alignas(64) ThreadCounters {
+    ThreadCounters() {
+        for (auto& counter : counters_) {
+            counter.packets.store(0, memory_order_relaxed);
+            counter.bytes.store(0, memory_order_relaxed);
+        }
+    }
+
+    Counter counters_[PacketCounters::MAX_IFINDEX + 1];
+};
+
+/// @brief Blocks of all threads which counted packets.
+mutex registry_mutex;
+vector<unique_ptr<ThreadCounters>> registry;
+
+/// @brief Incremented when the registry is cleared, so threads register a
+/// new block instead of using a released one.
+atomic<uint64_t> registry_generation(1);
+
+/// @brief Block of the current thread.
+///
+/// Kept trivially destructible on purpose: the blocks are owned by the
+/// registry and outlive the threads.
+thread_local ThreadCounters* local_counters = nullptr;
+thread_local uint64_t local_generation = 0;
+
+ThreadCounters*
+registerThread() {
+    lock_guard<mutex> lock(registry_mutex);
+    registry.emplace_back(new ThreadCounters());
+    local_counters = registry.back().get();
+    local_generation = registry_generation.load(memory_order_relaxed);
+    return (local_counters);
+}
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+void
+PacketCounters::count(unsigned int ifindex, size_t bytes) {
+    ThreadCounters* counters = local_counters;
+    if (!counters || local_generation != registry_generation.load(memory_order_acquire)) {
+        counters = registerThread();
+    }
+
+    // Only the owning thread writes the counter, a relaxed load and store
+    // avoids the locked read-modify-write while readers still see
+    // consistent values.
+    Counter& counter = counters->counters_[ifindex <= MAX_IFINDEX ? ifindex : 0];
+    counter.packets.store(counter.packets.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    counter.bytes.store(counter.bytes.load(memory_order_relaxed) + bytes, memory_order_relaxed);
+}
+
+map<unsigned int, PacketCounters::Totals>
+PacketCounters::collect() {
+    map<unsigned int, Totals> totals;
+
+    lock_guard<mutex> lock(registry_mutex);
+    for (auto const& counters : registry) {
+        for (unsigned int ifindex = 0; ifindex <= MAX_IFINDEX; ++ifindex) {
+            const Counter& counter = counters->counters_[ifindex];
+            uint64_t packets = counter.packets.load(memory_order_relaxed);
+            if (packets == 0) {
+                continue;
+            }
+            Totals& total = totals[ifindex];
+            total.packets += packets;
+            total.bytes += counter.bytes.load(memory_order_relaxed);
+        }
+    }
+
+    return (totals);
+}
+
+void
+PacketCounters::clear() {
+    lock_guard<mutex> lock(registry_mutex);
+    registry_generation.fetch_add(1, memory_order_release);
+    registry.clear();
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
@@ -0,0 +1,52 @@
+#ifndef INTERFACES_CMDS_COUNTERS_H
+#define INTERFACES_CMDS_COUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Per-interface counters of the received packets.
+///
+/// Every thread receiving packets owns a cache-line aligned block of
+/// counters indexed by the interface index, so counting takes no lock and
+/// threads do not share cache lines. Blocks are summed on demand.
+class PacketCounters {
+public:
+    /// @brief Highest interface index counted separately.
+    ///
+    /// Packets received on interfaces with a greater index are counted
+    /// together under the index 0, which is never used by the kernel.
+    static const unsigned int MAX_IFINDEX = 1023;
+
+    /// @brief Totals of an interface.
+    struct Totals {
+        uint64_t packets;
+        uint64_t bytes;
+    };
+
+    /// @brief Counts a packet received by the calling thread.
+    ///
+    /// @param ifindex Index of the receiving interface.
+    /// @param bytes Size of the packet.
+    static void count(unsigned int ifindex, size_t bytes);
+
+    /// @brief Sums the counters of all threads.
+    ///
+    /// @return Totals per interface index, interfaces without packets are
+    /// omitted.
+    static std::map<unsigned int, Totals> collect();
+
+    /// @brief Releases all counters.
+    ///
+    /// Must be called only when no packet is being processed, i.e. when
+    /// the library is unloaded.
+    static void clear();
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_COUNTERS_H
@@ -0,0 +1,119 @@
+#ifndef INTERFACES_CMDS_FAMILY_H
+#define INTERFACES_CMDS_FAMILY_H
+
+#include <asiolink/io_address.h>
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcpsrv/srv_config.h>
+#include <dhcpsrv/subnet.h>
+#include <dhcpsrv/subnet_id.h>
+
+#include <sys/socket.h>
+
+#include <cstdint>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Protocol family traits of the DHCPv4 server.
+///
+/// The command handlers, the tag index and the snapshots are templates
+/// over the family traits, so the subnets of the server are reached
+/// without testing the family on every call.
+struct Family4 {
+    /// @brief Protocol family.
+    static const uint16_t FAMILY = AF_INET;
+
+    /// @brief Standard port the server listens on.
+    static const uint16_t SERVER_PORT = DHCP4_SERVER_PORT;
+
+    /// @brief Whether 'dhcp-socket-type' and 'outbound-interface' are supported.
+    static const bool HAS_SOCKET_SETTINGS = true;
+
+    typedef dhcp::Subnet4Ptr SubnetPtr;
+    typedef dhcp::Subnet4Collection SubnetCollection;
+
+    /// @brief Server name used in the responses.
+    static const char* name() {
+        return ("dhcp4");
+    }
+
+    /// @brief Name of the other DHCP server.
+    static const char* siblingName() {
+        return ("dhcp6");
+    }
+
+    /// @brief Checks if an address belongs to the family.
+    ///
+    /// @param address Address to check.
+    static bool isFamilyAddress(const asiolink::IOAddress& address) {
+        return (address.isV4());
+    }
+
+    /// @brief Returns all subnets of a configuration.
+    ///
+    /// @param cfg Server configuration.
+    static const SubnetCollection* getAll(const dhcp::SrvConfigPtr& cfg) {
+        return (cfg->getCfgSubnets4()->getAll());
+    }
+
+    /// @brief Returns a subnet of a configuration, null if not found.
+    ///
+    /// @param cfg Server configuration.
+    /// @param id Subnet ID.
+    static SubnetPtr getSubnet(const dhcp::SrvConfigPtr& cfg, dhcp::SubnetID id) {
+        return (cfg->getCfgSubnets4()->getSubnet(id));
+    }
+};
+
+/// @brief Protocol family traits of the DHCPv6 server.
+struct Family6 {
+    /// @brief Protocol family.
+    static const uint16_t FAMILY = AF_INET6;
+
+    /// @brief Standard port the server listens on.
+    static const uint16_t SERVER_PORT = DHCP6_SERVER_PORT;
+
+    /// @brief Whether 'dhcp-socket-type' and 'outbound-interface' are supported.
+    static const bool HAS_SOCKET_SETTINGS = false;
+
+    typedef dhcp::Subnet6Ptr SubnetPtr;
+    typedef dhcp::Subnet6Collection SubnetCollection;
+
+    /// @brief Server name used in the responses.
+    static const char* name() {
+        return ("dhcp6");
+    }
+
+    /// @brief Name of the other DHCP server.
+    static const char* siblingName() {
+        return ("dhcp4");
+    }
+
+    /// @brief Checks if an address belongs to the family.
+    ///
+    /// @param address Address to check.
+    static bool isFamilyAddress(const asiolink::IOAddress& address) {
+        return (address.isV6());
+    }
+
+    /// @brief Returns all subnets of a configuration.
+    ///
+    /// @param cfg Server configuration.
+    static const SubnetCollection* getAll(const dhcp::SrvConfigPtr& cfg) {
+        return (cfg->getCfgSubnets6()->getAll());
+    }
+
+    /// @brief Returns a subnet of a configuration, null if not found.
+    ///
+    /// @param cfg Server configuration.
+    /// @param id Subnet ID.
+    static SubnetPtr getSubnet(const dhcp::SrvConfigPtr& cfg, dhcp::SubnetID id) {
+        return (cfg->getCfgSubnets6()->getSubnet(id));
+    }
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_FAMILY_H
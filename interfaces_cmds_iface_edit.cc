@@ -0,0 +1,136 @@
+#include <config.h>
+
+#include <cc/data.h>
+
+#include <unordered_set>
+
+#include <interfaces_cmds_iface_edit.h>
+
+using namespace isc::dhcp;
+using namespace isc::data;
+using namespace std;
+
+namespace {
+
+// Returns the interface name part of a "name/address" entry.
+string
+entryName(const string& entry) {
+    return (entry.substr(0, entry.find('/')));
+}
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+CfgIfaceEditor::CfgIfaceEditor(uint16_t family, const CfgIfacePtr& cfg_iface)
+    : family_(family), cfg_iface_(cfg_iface) {
+}
+
+vector<string>
+CfgIfaceEditor::getEntries() const {
+    vector<string> entries;
+    ConstElementPtr interfaces = cfg_iface_->toElement()->get("interfaces");
+    if (!interfaces) {
+        return (entries);
+    }
+    entries.reserve(interfaces->size());
+    for (auto const& el : interfaces->listValue()) {
+        entries.push_back(el->stringValue());
+    }
+    return (entries);
+}
+
+vector<string>
+CfgIfaceEditor::remove(const vector<string>& entries) {
+    vector<string> current = getEntries();
+    unordered_set<string> removed(entries.begin(), entries.end());
+    unordered_set<string> matched;
+
+    // Single pass over the configured entries with hashed lookups of both
+    // the full entry and its interface name.
+    vector<string> survivors;
+    survivors.reserve(current.size());
+    for (auto const& entry : current) {
+        if (removed.count(entry)) {
+            matched.insert(entry);
+            continue;
+        }
+        string name = entryName(entry);
+        if (name != entry && removed.count(name)) {
+            matched.insert(name);
+            continue;
+        }
+        survivors.push_back(entry);
+    }
+
+    vector<string> missing;
+    for (auto const& entry : entries) {
+        if (!matched.count(entry)) {
+            missing.push_back(entry);
+        }
+    }
+    if (!missing.empty() || survivors.size() == current.size()) {
+        return (missing);
+    }
+
+    replace(survivors);
+    return (missing);
+}
+
+void
+CfgIfaceEditor::replace(const vector<string>& entries) {
+    // An interface with unicast addresses is fully described by its
+    // "name/address" entries, using its bare name again would be rejected
+    // as a duplicate.
+    unordered_set<string> with_address;
+    for (auto const& entry : entries) {
+        string name = entryName(entry);
+        if (name != entry) {
+            with_address.insert(name);
+        }
+    }
+    vector<string> applied;
+    applied.reserve(entries.size());
+    for (auto const& entry : entries) {
+        if (entryName(entry) == entry && with_address.count(entry)) {
+            continue;
+        }
+        applied.push_back(entry);
+    }
+
+    // Validate the new list on a scratch configuration first, so a failure
+    // leaves the live configuration untouched.
+    CfgIface staged;
+    for (auto const& entry : applied) {
+        staged.use(family_, entry);
+    }
+
+    // CfgIface::reset() also resets the socket type, keep all the settings
+    // which are not part of the interfaces list.
+    CfgIface::SocketType socket_type = cfg_iface_->getSocketType();
+    CfgIface::OutboundIface outbound_iface = cfg_iface_->getOutboundIface();
+    bool re_detect = cfg_iface_->getReDetect();
+    bool require_all = cfg_iface_->getServiceSocketsRequireAll();
+    uint32_t max_retries = cfg_iface_->getServiceSocketsMaxRetries();
+    uint32_t retry_wait_time = cfg_iface_->getServiceSocketsRetryWaitTime();
+    ConstElementPtr context = cfg_iface_->getContext();
+
+    cfg_iface_->reset();
+    for (auto const& entry : applied) {
+        cfg_iface_->use(family_, entry);
+    }
+
+    if (family_ == AF_INET) {
+        cfg_iface_->useSocketType(AF_INET, socket_type);
+        cfg_iface_->setOutboundIface(outbound_iface);
+    }
+    cfg_iface_->setReDetect(re_detect);
+    cfg_iface_->setServiceSocketsRequireAll(require_all);
+    cfg_iface_->setServiceSocketsMaxRetries(max_retries);
+    cfg_iface_->setServiceSocketsRetryWaitTime(retry_wait_time);
+    cfg_iface_->setContext(context);
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
@@ -0,0 +1,64 @@
+#ifndef INTERFACES_CMDS_IFACE_EDIT_H
+#define INTERFACES_CMDS_IFACE_EDIT_H
+
+#include <dhcpsrv/cfg_iface.h>
+
+#include <string>
+#include <vector>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Applies interface removals to the global interfaces configuration.
+///
+/// @c CfgIface has no method to remove a single interface, so the editor
+/// computes the set difference between the configured interfaces and the
+/// removed ones and rebuilds the interface list only when something really
+/// changes. Unicast addresses ("name/address" entries) of the remaining
+/// interfaces and the other interfaces-config settings (socket type,
+/// outbound interface, re-detect, service sockets retries and user context)
+/// are preserved.
+class CfgIfaceEditor {
+public:
+    /// @brief Constructor.
+    ///
+    /// @param family Protocol family (AF_INET or AF_INET6).
+    /// @param cfg_iface Interfaces configuration to edit.
+    CfgIfaceEditor(uint16_t family, const dhcp::CfgIfacePtr& cfg_iface);
+
+    /// @brief Returns the configured interface entries.
+    ///
+    /// Entries are interface names, "name/address" for unicast addresses
+    /// and "*" for the wildcard.
+    std::vector<std::string> getEntries() const;
+
+    /// @brief Removes interfaces from the configuration.
+    ///
+    /// A bare interface name removes every entry of that interface, a
+    /// "name/address" entry removes only that unicast address. Nothing is
+    /// changed when any of the requested entries is not configured.
+    ///
+    /// @param entries Entries to remove.
+    ///
+    /// @return Requested entries which are not configured. Empty on success.
+    std::vector<std::string> remove(const std::vector<std::string>& entries);
+
+    /// @brief Replaces configured entries keeping the other settings.
+    ///
+    /// The configuration is left untouched if any entry is rejected.
+    ///
+    /// @param entries New list of entries, e.g. as returned by @c getEntries.
+    void replace(const std::vector<std::string>& entries);
+
+private:
+    /// @brief Protocol family (IPv4 or IPv6)
+    uint16_t family_;
+
+    /// @brief Edited interfaces configuration.
+    dhcp::CfgIfacePtr cfg_iface_;
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_IFACE_EDIT_H
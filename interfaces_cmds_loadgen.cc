@@ -0,0 +1,383 @@
+// Load generator for the interfaces commands.
+//
+// Replays a mix of 'available-interfaces', 'get-interfaces', 'append-interfaces'
+// and 'delete-interfaces' commands from concurrent clients against the local
+// unix control socket of kea-dhcp4 or kea-dhcp6 and reports the throughput and
+// latency percentiles. It depends on nothing but POSIX, so it can run on the
+// server host while it is serving DHCP traffic.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+/// @brief Commands the generator can send.
+const char* COMMANDS[] = {
+    "available-interfaces",
+    "get-interfaces",
+    "append-interfaces",
+    "delete-interfaces",
+};
+
+const size_t COMMANDS_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+/// @brief Run parameters.
+struct Options {
+    string socket_path;
+    unsigned int clients = 4;
+    uint64_t requests = 1000;
+    double duration = 0;
+    unsigned int weights[COMMANDS_COUNT] = { 70, 20, 5, 5 };
+    string interface = "lo";
+    string section = "global";
+    int64_t subnet_id = 1;
+    int timeout = 5000;
+};
+
+/// @brief Results of one client.
+struct ClientResult {
+    vector<uint64_t> latencies;
+    uint64_t sent[COMMANDS_COUNT] = { 0, 0, 0, 0 };
+    uint64_t error_responses = 0;
+    uint64_t transport_failures = 0;
+};
+
+void
+usage() {
+    cerr << "Usage: interfaces_cmds_loadgen --socket <path> [options]\n"
+         << "\n"
+         << "  --socket <path>       Kea unix control socket (required)\n"
+         << "  --clients <n>         concurrent clients (default 4)\n"
+         << "  --requests <n>        requests per client (default 1000)\n"
+         << "  --duration <seconds>  run for a fixed time instead of a number of requests\n"
+         << "  --mix <list>          command weights, e.g. available-interfaces=70,\n"
+         << "                        get-interfaces=20,append-interfaces=5,delete-interfaces=5\n"
+         << "  --interface <name>    interface used by append/delete (default lo)\n"
+         << "  --section <name>      global or subnet (default global)\n"
+         << "  --subnet-id <id>      subnet used by the subnet section (default 1)\n"
+         << "  --timeout <ms>        per request timeout (default 5000)\n";
+}
+
+void
+parseMix(const string& mix, Options& options) {
+    fill(begin(options.weights), end(options.weights), 0);
+    stringstream ss(mix);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t eq = item.find('=');
+        string name = item.substr(0, eq);
+        unsigned int weight = (eq == string::npos ? 1 : stoul(item.substr(eq + 1)));
+        size_t i = 0;
+        for (; i < COMMANDS_COUNT; ++i) {
+            if (name == COMMANDS[i]) {
+                options.weights[i] = weight;
+                break;
+            }
+        }
+        if (i == COMMANDS_COUNT) {
+            throw runtime_error("unknown command in --mix: " + name);
+        }
+    }
+}
+
+Options
+parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            usage();
+            exit(0);
+        }
+        if (i + 1 >= argc) {
+            throw runtime_error("missing value for " + arg);
+        }
+        string value = argv[++i];
+        if (arg == "--socket") {
+            options.socket_path = value;
+        } else if (arg == "--clients") {
+            options.clients = stoul(value);
+        } else if (arg == "--requests") {
+            options.requests = stoull(value);
+        } else if (arg == "--duration") {
+            options.duration = stod(value);
+        } else if (arg == "--mix") {
+            parseMix(value, options);
+        } else if (arg == "--interface") {
+            options.interface = value;
+        } else if (arg == "--section") {
+            options.section = value;
+        } else if (arg == "--subnet-id") {
+            options.subnet_id = stoll(value);
+        } else if (arg == "--timeout") {
+            options.timeout = stoi(value);
+        } else {
+            throw runtime_error("unknown option " + arg);
+        }
+    }
+    if (options.socket_path.empty()) {
+        throw runtime_error("--socket is required");
+    }
+    if (options.clients == 0) {
+        throw runtime_error("--clients must be positive");
+    }
+    if (all_of(begin(options.weights), end(options.weights),
+               [](unsigned int w) { return (w == 0); })) {
+        throw runtime_error("--mix selects no command");
+    }
+    if (options.section != "global" && options.section != "subnet") {
+        throw runtime_error("--section must be global or subnet");
+    }
+    return (options);
+}
+
+string
+buildCommand(size_t command, const Options& options) {
+    ostringstream json;
+    json << "{ \"command\": \"" << COMMANDS[command] << "\", \"arguments\": {";
+    if (command != 0) {
+        json << " \"section\": \"" << options.section << "\"";
+        if (options.section == "subnet") {
+            json << ", \"subnet_id\": " << options.subnet_id;
+        }
+        if (command >= 2) {
+            json << ", \"interfaces\": [ \"" << options.interface << "\" ]";
+        }
+        json << " ";
+    }
+    json << "} }";
+    return (json.str());
+}
+
+// Returns true when the buffer holds a complete JSON object or list.
+//
+// Same scanner as in interfaces_cmds_sibling.cc, copied as this tool is
+// built without the hook library.
+bool
+isComplete(const string& buffer) {
+    int depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    bool started = false;
+    for (char c : buffer) {
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+            }
+            continue;
+        }
+        if (c == '"') {
+            in_string = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+            started = true;
+        } else if (c == '}' || c == ']') {
+            --depth;
+        }
+    }
+    return (started && depth == 0);
+}
+
+// Result codes of the control channel answers (CONTROL_RESULT_* in Kea),
+// 3 (empty) is a normal answer e.g. for a subnet without interface.
+const int RESULT_ERROR = 1;
+const int RESULT_COMMAND_UNSUPPORTED = 2;
+
+// Returns the first "result" value of the response, -1 if there is none.
+int
+parseResult(const string& response) {
+    size_t pos = response.find("\"result\"");
+    if (pos == string::npos) {
+        return (-1);
+    }
+    pos = response.find(':', pos);
+    if (pos == string::npos) {
+        return (-1);
+    }
+    return (atoi(response.c_str() + pos + 1));
+}
+
+// Sends one command and waits for the whole response. Kea handles one
+// command per connection, so every request opens a new one.
+bool
+sendCommand(const Options& options, const string& command, string& response) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return (false);
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, options.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return (false);
+    }
+
+    size_t written = 0;
+    while (written < command.size()) {
+        ssize_t n = send(fd, command.data() + written, command.size() - written, MSG_NOSIGNAL);
+        if (n <= 0) {
+            close(fd);
+            return (false);
+        }
+        written += n;
+    }
+
+    response.clear();
+    char buffer[65536];
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    for (;;) {
+        int ready = poll(&pfd, 1, options.timeout);
+        if (ready <= 0) {
+            close(fd);
+            return (false);
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0) {
+            close(fd);
+            return (false);
+        }
+        if (n == 0) {
+            break;
+        }
+        response.append(buffer, n);
+        if (isComplete(response)) {
+            break;
+        }
+    }
+
+    close(fd);
+    return (isComplete(response));
+}
+
+void
+runClient(const Options& options, unsigned int id, const Clock::time_point& deadline,
+          ClientResult& result) {
+    mt19937 generator(id + 1);
+    discrete_distribution<size_t> pick(begin(options.weights), end(options.weights));
+
+    vector<string> commands;
+    for (size_t i = 0; i < COMMANDS_COUNT; ++i) {
+        commands.push_back(buildCommand(i, options));
+    }
+
+    string response;
+    for (uint64_t i = 0; ; ++i) {
+        if (options.duration > 0) {
+            if (Clock::now() >= deadline) {
+                break;
+            }
+        } else if (i >= options.requests) {
+            break;
+        }
+
+        size_t command = pick(generator);
+        Clock::time_point start = Clock::now();
+        bool ok = sendCommand(options, commands[command], response);
+        Clock::time_point end = Clock::now();
+
+        ++result.sent[command];
+        if (!ok) {
+            ++result.transport_failures;
+            continue;
+        }
+        result.latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+        int rcode = parseResult(response);
+        if (rcode == RESULT_ERROR || rcode == RESULT_COMMAND_UNSUPPORTED) {
+            ++result.error_responses;
+        }
+    }
+}
+
+double
+percentile(const vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return (0);
+    }
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return (sorted[index] / 1000.0);
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const exception& ex) {
+        cerr << "interfaces_cmds_loadgen: " << ex.what() << "\n\n";
+        usage();
+        return (2);
+    }
+
+    vector<ClientResult> results(options.clients);
+    vector<thread> clients;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + chrono::duration_cast<Clock::duration>(
+        chrono::duration<double>(options.duration));
+    for (unsigned int i = 0; i < options.clients; ++i) {
+        clients.emplace_back(runClient, cref(options), i, cref(deadline), ref(results[i]));
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    double elapsed = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<uint64_t> latencies;
+    uint64_t sent[COMMANDS_COUNT] = { 0, 0, 0, 0 };
+    uint64_t error_responses = 0;
+    uint64_t transport_failures = 0;
+    for (auto const& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        for (size_t i = 0; i < COMMANDS_COUNT; ++i) {
+            sent[i] += result.sent[i];
+        }
+        error_responses += result.error_responses;
+        transport_failures += result.transport_failures;
+    }
+    sort(latencies.begin(), latencies.end());
+
+    printf("clients:            %u\n", options.clients);
+    printf("duration:           %.3f s\n", elapsed);
+    printf("completed:          %zu\n", latencies.size());
+    printf("error responses:    %" PRIu64 "\n", error_responses);
+    printf("transport failures: %" PRIu64 "\n", transport_failures);
+    printf("throughput:         %.1f req/s\n", elapsed > 0 ? latencies.size() / elapsed : 0);
+    printf("latency p50:        %.1f us\n", percentile(latencies, 0.50));
+    printf("latency p99:        %.1f us\n", percentile(latencies, 0.99));
+    printf("latency p999:       %.1f us\n", percentile(latencies, 0.999));
+    printf("latency max:        %.1f us\n", latencies.empty() ? 0 : latencies.back() / 1000.0);
+    for (size_t i = 0; i < COMMANDS_COUNT; ++i) {
+        printf("%-20s%" PRIu64 "\n", (string(COMMANDS[i]) + ":").c_str(), sent[i]);
+    }
+
+    return (transport_failures == 0 ? 0 : 1);
+}
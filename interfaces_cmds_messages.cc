@@ -16,6 +16,19 @@ extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_SET = "INTERFACES_CM
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_SET_HANDLER_FAILED = "INTERFACES_CMDS_INTERFACES_SET_HANDLER_FAILED";
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_DELETE = "INTERFACES_CMDS_INTERFACES_DELETE";
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_DELETE_HANDLER_FAILED = "INTERFACES_CMDS_INTERFACES_DELETE_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_TAG_INDEX_BUILT = "INTERFACES_CMDS_TAG_INDEX_BUILT";
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_GET = "INTERFACES_CMDS_SETTINGS_GET";
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED = "INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_SET = "INTERFACES_CMDS_SETTINGS_SET";
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED = "INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_SOCKETS_REOPENED = "INTERFACES_CMDS_SOCKETS_REOPENED";
+extern const isc::log::MessageID INTERFACES_CMDS_SIBLING_FAILED = "INTERFACES_CMDS_SIBLING_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_SNAPSHOTS_GET = "INTERFACES_CMDS_SNAPSHOTS_GET";
+extern const isc::log::MessageID INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED = "INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_ROLLBACK = "INTERFACES_CMDS_ROLLBACK";
+extern const isc::log::MessageID INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED = "INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED = "INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED";
+extern const isc::log::MessageID INTERFACES_CMDS_SIBLING_UNKNOWN = "INTERFACES_CMDS_SIBLING_UNKNOWN";
 
 namespace {
 
@@ -35,6 +48,19 @@ const char* values[] = {
     "INTERFACES_CMDS_INTERFACES_SET_HANDLER_FAILED", "An error occurred set interfaces in configuration.",
     "INTERFACES_CMDS_INTERFACES_DELETE", "Interfaced deleted successfully.",
     "INTERFACES_CMDS_INTERFACES_DELETE_HANDLER_FAILED", "An error occurred delete interfaces in configuration.",
+    "INTERFACES_CMDS_TAG_INDEX_BUILT", "Subnet user-context index built. Subnets: %1, keys: %2.",
+    "INTERFACES_CMDS_SETTINGS_GET", "Interfaces settings returned successfully.",
+    "INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED", "An error occurred while retrieving interfaces settings in configuration.",
+    "INTERFACES_CMDS_SETTINGS_SET", "Interfaces settings updated successfully.",
+    "INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED", "An error occurred set interfaces settings in configuration.",
+    "INTERFACES_CMDS_SOCKETS_REOPENED", "DHCP sockets reopened on port %1.",
+    "INTERFACES_CMDS_SIBLING_FAILED", "Sibling server %1 failed to apply the interfaces change, local change reverted: %2",
+    "INTERFACES_CMDS_SNAPSHOTS_GET", "Interfaces snapshots returned successfully.",
+    "INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED", "An error occurred while retrieving interfaces snapshots.",
+    "INTERFACES_CMDS_ROLLBACK", "Interfaces configuration rolled back to snapshot %1.",
+    "INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED", "An error occurred roll back interfaces configuration.",
+    "INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED", "An error occurred while dumping trace events.",
+    "INTERFACES_CMDS_SIBLING_UNKNOWN", "Result of the interfaces change on sibling server %1 is unknown, local change kept: %2",
 };
 
 const isc::log::MessageInitializer initializer(values);
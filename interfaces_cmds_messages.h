@@ -18,5 +18,18 @@ extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_SET;
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_SET_HANDLER_FAILED;
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_DELETE;
 extern const isc::log::MessageID INTERFACES_CMDS_INTERFACES_DELETE_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_TAG_INDEX_BUILT;
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_GET;
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_GET_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_SET;
+extern const isc::log::MessageID INTERFACES_CMDS_SETTINGS_SET_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_SOCKETS_REOPENED;
+extern const isc::log::MessageID INTERFACES_CMDS_SIBLING_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_SNAPSHOTS_GET;
+extern const isc::log::MessageID INTERFACES_CMDS_SNAPSHOTS_GET_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_ROLLBACK;
+extern const isc::log::MessageID INTERFACES_CMDS_ROLLBACK_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_TRACE_DUMP_HANDLER_FAILED;
+extern const isc::log::MessageID INTERFACES_CMDS_SIBLING_UNKNOWN;
 
 #endif
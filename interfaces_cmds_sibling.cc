@@ -0,0 +1,169 @@
+#include <config.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <interfaces_cmds_sibling.h>
+
+using namespace isc::data;
+using namespace std;
+
+namespace {
+
+/// @brief Closes the socket when leaving the scope.
+class SocketGuard {
+public:
+    explicit SocketGuard(int fd) : fd_(fd) {
+    }
+
+    ~SocketGuard() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    int get() const {
+        return (fd_);
+    }
+
+private:
+    int fd_;
+};
+
+void
+waitFor(int fd, short events, int timeout, const string& socket_path) {
+    struct pollfd pfd = { fd, events, 0 };
+    int ready;
+    do {
+        ready = poll(&pfd, 1, timeout);
+    } while (ready < 0 && errno == EINTR);
+
+    if (ready == 0) {
+        isc_throw(isc::interfaces_cmds::SiblingError, "timeout on control socket " << socket_path);
+    }
+    if (ready < 0) {
+        isc_throw(isc::interfaces_cmds::SiblingError, "failed to poll control socket "
+                  << socket_path << ": " << strerror(errno));
+    }
+}
+
+// Returns true when the buffer holds a complete JSON object or list.
+bool
+isComplete(const string& buffer) {
+    int depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    bool started = false;
+    for (char c : buffer) {
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+            }
+            continue;
+        }
+        if (c == '"') {
+            in_string = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+            started = true;
+        } else if (c == '}' || c == ']') {
+            --depth;
+        }
+    }
+    return (started && depth == 0);
+}
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+ConstElementPtr
+sendSiblingCommand(const string& socket_path, const ConstElementPtr& command, int timeout) {
+    struct sockaddr_un addr;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        isc_throw(SiblingError, "control socket path " << socket_path << " is too long");
+    }
+
+    SocketGuard fd(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (fd.get() < 0) {
+        isc_throw(SiblingError, "failed to create socket: " << strerror(errno));
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd.get(), reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        isc_throw(SiblingError, "failed to connect to control socket "
+                  << socket_path << ": " << strerror(errno));
+    }
+
+    // Once any byte is sent the sibling may apply the command, failures are
+    // then reported as indeterminate.
+    string request = command->str();
+    size_t written = 0;
+    string response;
+    try {
+        while (written < request.size()) {
+            waitFor(fd.get(), POLLOUT, timeout, socket_path);
+            ssize_t n = send(fd.get(), request.data() + written, request.size() - written, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                isc_throw(SiblingError, "failed to send to control socket "
+                          << socket_path << ": " << strerror(errno));
+            }
+            written += n;
+        }
+
+        // The daemon closes the connection once the response is sent, the
+        // completeness check only avoids waiting for it.
+        char buffer[8192];
+        while (!isComplete(response)) {
+            waitFor(fd.get(), POLLIN, timeout, socket_path);
+            ssize_t n = recv(fd.get(), buffer, sizeof(buffer), 0);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                isc_throw(SiblingError, "failed to receive from control socket "
+                          << socket_path << ": " << strerror(errno));
+            }
+            if (n == 0) {
+                break;
+            }
+            response.append(buffer, n);
+        }
+    } catch (const SiblingError& ex) {
+        if (written == 0) {
+            throw;
+        }
+        isc_throw(SiblingIndeterminate, ex.what() << ", the command may have been applied");
+    }
+
+    try {
+        ConstElementPtr answer = Element::fromJSON(response);
+        // Answers relayed by the Control Agent are lists, take the daemon one.
+        if (answer->getType() == Element::list && answer->size() > 0) {
+            answer = answer->get(0);
+        }
+        return (answer);
+    } catch (const std::exception& ex) {
+        isc_throw(SiblingIndeterminate, "invalid response from control socket "
+                  << socket_path << ": " << ex.what() << ", the command may have been applied");
+    }
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
@@ -0,0 +1,54 @@
+#ifndef INTERFACES_CMDS_SIBLING_H
+#define INTERFACES_CMDS_SIBLING_H
+
+#include <cc/data.h>
+#include <exceptions/exceptions.h>
+
+#include <string>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Exception thrown when the sibling daemon can not be reached.
+class SiblingError : public isc::Exception {
+public:
+    SiblingError(const char* file, size_t line, const char* what)
+        : isc::Exception(file, line, what) {
+    }
+};
+
+/// @brief Exception thrown when the command was sent to the sibling daemon
+/// but its answer is unknown (timeout, broken connection or invalid answer).
+///
+/// The sibling may still apply the command, so it can not be considered as
+/// rejected.
+class SiblingIndeterminate : public SiblingError {
+public:
+    SiblingIndeterminate(const char* file, size_t line, const char* what)
+        : SiblingError(file, line, what) {
+    }
+};
+
+/// @brief Sends a command to the sibling DHCP daemon.
+///
+/// The DHCPv4 and DHCPv6 servers run in separate processes, dual-stack
+/// changes are forwarded to the other one over its local unix control
+/// socket. The call blocks until the whole response is received, up to
+/// the timeout for each I/O step.
+///
+/// @param socket_path Path of the sibling unix control socket.
+/// @param command Command to send.
+/// @param timeout Maximum time in milliseconds to wait for each I/O step.
+///
+/// @return Answer of the sibling daemon.
+/// @throw SiblingError if the command could not be sent.
+/// @throw SiblingIndeterminate if the command was sent (even partially) but
+/// no valid answer was received.
+data::ConstElementPtr
+sendSiblingCommand(const std::string& socket_path, const data::ConstElementPtr& command,
+                   int timeout);
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_SIBLING_H
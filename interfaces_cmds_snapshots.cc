@@ -0,0 +1,207 @@
+#include <config.h>
+
+#include <dhcpsrv/cfgmgr.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include <interfaces_cmds_family.h>
+#include <interfaces_cmds_snapshots.h>
+
+using namespace isc::dhcp;
+using namespace isc::data;
+using namespace isc::interfaces_cmds;
+using namespace std;
+
+namespace {
+
+typedef vector<pair<SubnetID, string>> ChunkEntries;
+
+mutex snapshots_mutex;
+deque<InterfacesSnapshotPtr> snapshots;
+size_t snapshots_depth = InterfacesSnapshots::DEFAULT_DEPTH;
+uint64_t next_snapshot_id = 1;
+
+/// @brief Builds the chunks of the current subnets reusing the chunks of
+/// the previous snapshot.
+///
+/// Entries of a chunk are gathered in a reused buffer and compared with the
+/// previous chunk in place, a new chunk is allocated only for a range which
+/// changed.
+class ChunksBuilder {
+public:
+    ChunksBuilder(const InterfacesSnapshot* previous, map<uint32_t, SnapshotChunkPtr>& chunks)
+        : previous_(previous), chunks_(chunks), key_(0), changed_(false) {
+    }
+
+    template<typename SubnetCollection>
+    void build(const SubnetCollection* subnets) {
+        // Subnets are iterated in ascending order of their IDs, so the
+        // chunks are completed one after another. Interfaces inherited from
+        // a shared network are not recorded, so a rollback never sets them
+        // on the subnets.
+        for (auto const& subnet : *subnets) {
+            string iface = subnet->getIface(Network::Inheritance::NONE).valueOr("");
+            if (iface.empty()) {
+                continue;
+            }
+            uint32_t key = subnet->getID() / SnapshotChunk::SIZE;
+            if (key != key_) {
+                flush();
+                key_ = key;
+            }
+            pending_.emplace_back(subnet->getID(), iface);
+        }
+        flush();
+
+        // All chunks reused and as many of them as before means the same
+        // set of ranges.
+        if (!previous_ || chunks_.size() != previous_->chunks_.size()) {
+            changed_ = true;
+        }
+    }
+
+    bool changed() const {
+        return (changed_);
+    }
+
+private:
+    void flush() {
+        if (pending_.empty()) {
+            return;
+        }
+        SnapshotChunkPtr chunk;
+        if (previous_) {
+            auto found = previous_->chunks_.find(key_);
+            if (found != previous_->chunks_.end() && found->second->entries_ == pending_) {
+                chunk = found->second;
+            }
+        }
+        if (!chunk) {
+            boost::shared_ptr<SnapshotChunk> created(new SnapshotChunk());
+            created->entries_ = pending_;
+            chunk = created;
+            changed_ = true;
+        }
+        chunks_[key_] = chunk;
+        pending_.clear();
+    }
+
+    const InterfacesSnapshot* previous_;
+    map<uint32_t, SnapshotChunkPtr>& chunks_;
+    ChunkEntries pending_;
+    uint32_t key_;
+    bool changed_;
+};
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+string
+InterfacesSnapshot::getIface(SubnetID id) const {
+    auto chunk = chunks_.find(id / SnapshotChunk::SIZE);
+    if (chunk == chunks_.end()) {
+        return ("");
+    }
+    const ChunkEntries& entries = chunk->second->entries_;
+    auto entry = lower_bound(entries.begin(), entries.end(), id,
+                             [](const pair<SubnetID, string>& e, SubnetID value) {
+                                 return (e.first < value);
+                             });
+    if (entry == entries.end() || entry->first != id) {
+        return ("");
+    }
+    return (entry->second);
+}
+
+template<typename Family>
+InterfacesSnapshotPtr
+InterfacesSnapshots::capture() {
+    lock_guard<mutex> lock(snapshots_mutex);
+    SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+    const InterfacesSnapshot* previous = (snapshots.empty() ? 0 : snapshots.back().get());
+
+    boost::shared_ptr<InterfacesSnapshot> snapshot(new InterfacesSnapshot());
+
+    // CfgIface::toElement() omits the settings which have their default
+    // value, and the retry wait time while retries are disabled. They are
+    // all recorded, so states differing only by them are not taken as
+    // equal and a rollback restores them.
+    CfgIfacePtr cfg_iface = current->getCfgIface();
+    ElementPtr settings = isc::data::copy(cfg_iface->toElement());
+    if (Family::HAS_SOCKET_SETTINGS) {
+        settings->set("dhcp-socket-type", Element::create(cfg_iface->socketTypeToText()));
+        settings->set("outbound-interface", Element::create(cfg_iface->outboundTypeToText()));
+    }
+    settings->set("re-detect", Element::create(cfg_iface->getReDetect()));
+    settings->set("service-sockets-require-all", Element::create(cfg_iface->getServiceSocketsRequireAll()));
+    settings->set("service-sockets-max-retries",
+                  Element::create(static_cast<int64_t>(cfg_iface->getServiceSocketsMaxRetries())));
+    settings->set("service-sockets-retry-wait-time",
+                  Element::create(static_cast<int64_t>(cfg_iface->getServiceSocketsRetryWaitTime())));
+
+    ConstElementPtr interfaces_config = settings;
+    bool changed = true;
+    if (previous && previous->interfaces_config_->equals(*interfaces_config)) {
+        interfaces_config = previous->interfaces_config_;
+        changed = false;
+    }
+    snapshot->interfaces_config_ = interfaces_config;
+
+    ChunksBuilder builder(previous, snapshot->chunks_);
+    builder.build(Family::getAll(current));
+
+    if (!changed && !builder.changed()) {
+        return (snapshots.back());
+    }
+
+    snapshot->id_ = next_snapshot_id++;
+    snapshot->timestamp_ = time(0);
+    snapshots.push_back(snapshot);
+    while (snapshots.size() > snapshots_depth) {
+        snapshots.pop_front();
+    }
+    return (snapshot);
+}
+
+template InterfacesSnapshotPtr InterfacesSnapshots::capture<Family4>();
+template InterfacesSnapshotPtr InterfacesSnapshots::capture<Family6>();
+
+InterfacesSnapshotPtr
+InterfacesSnapshots::get(uint64_t id) {
+    lock_guard<mutex> lock(snapshots_mutex);
+    for (auto const& snapshot : snapshots) {
+        if (snapshot->id_ == id) {
+            return (snapshot);
+        }
+    }
+    return (InterfacesSnapshotPtr());
+}
+
+vector<InterfacesSnapshotPtr>
+InterfacesSnapshots::getAll() {
+    lock_guard<mutex> lock(snapshots_mutex);
+    return (vector<InterfacesSnapshotPtr>(snapshots.begin(), snapshots.end()));
+}
+
+void
+InterfacesSnapshots::setDepth(size_t depth) {
+    lock_guard<mutex> lock(snapshots_mutex);
+    snapshots_depth = max(depth, static_cast<size_t>(MIN_DEPTH));
+    while (snapshots.size() > snapshots_depth) {
+        snapshots.pop_front();
+    }
+}
+
+void
+InterfacesSnapshots::clear() {
+    lock_guard<mutex> lock(snapshots_mutex);
+    snapshots.clear();
+    snapshots_depth = DEFAULT_DEPTH;
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
@@ -0,0 +1,102 @@
+#ifndef INTERFACES_CMDS_SNAPSHOTS_H
+#define INTERFACES_CMDS_SNAPSHOTS_H
+
+#include <cc/data.h>
+#include <dhcpsrv/subnet_id.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Interfaces of a range of subnet IDs.
+///
+/// Holds the subnets of the range which have an interface set, ordered by
+/// subnet ID. Chunks are immutable and shared by all snapshots in which
+/// the range did not change.
+struct SnapshotChunk {
+    /// @brief Number of subnet IDs covered by a chunk.
+    static const uint32_t SIZE = 64;
+
+    std::vector<std::pair<dhcp::SubnetID, std::string>> entries_;
+};
+
+typedef boost::shared_ptr<const SnapshotChunk> SnapshotChunkPtr;
+
+/// @brief Immutable copy of the interfaces configuration.
+///
+/// Unchanged parts are shared with the previous snapshot, so a snapshot
+/// costs the chunks that changed and one pointer per chunk.
+struct InterfacesSnapshot {
+    /// @brief Returns the interface of a subnet, empty if not set.
+    ///
+    /// @param id Subnet ID.
+    std::string getIface(dhcp::SubnetID id) const;
+
+    /// @brief Identifier, increasing with every snapshot.
+    uint64_t id_;
+
+    /// @brief Time of the capture.
+    time_t timestamp_;
+
+    /// @brief Global interfaces-config as returned by @c CfgIface::toElement,
+    /// completed with the settings it omits when they have their default value.
+    data::ConstElementPtr interfaces_config_;
+
+    /// @brief Subnets interfaces by chunk index (subnet ID / @c SnapshotChunk::SIZE).
+    std::map<uint32_t, SnapshotChunkPtr> chunks_;
+};
+
+typedef boost::shared_ptr<const InterfacesSnapshot> InterfacesSnapshotPtr;
+
+/// @brief Bounded history of the interfaces configurations.
+class InterfacesSnapshots {
+public:
+    /// @brief Default number of snapshots kept.
+    static const size_t DEFAULT_DEPTH = 10;
+
+    /// @brief Minimum number of snapshots kept.
+    ///
+    /// The latest snapshot is the current configuration, one more is needed
+    /// to have something to roll back to.
+    static const size_t MIN_DEPTH = 2;
+
+    /// @brief Records the current configuration.
+    ///
+    /// Nothing is recorded when the configuration equals the latest
+    /// snapshot. The oldest snapshot is dropped when the depth is exceeded.
+    ///
+    /// @tparam Family Protocol family traits, @c Family4 or @c Family6.
+    ///
+    /// @return Snapshot of the current configuration.
+    template<typename Family>
+    static InterfacesSnapshotPtr capture();
+
+    /// @brief Returns a snapshot by its identifier, null if not kept.
+    ///
+    /// @param id Snapshot identifier.
+    static InterfacesSnapshotPtr get(uint64_t id);
+
+    /// @brief Returns kept snapshots from the oldest to the latest.
+    static std::vector<InterfacesSnapshotPtr> getAll();
+
+    /// @brief Sets the number of snapshots kept.
+    ///
+    /// @param depth Number of snapshots, at least @c MIN_DEPTH.
+    static void setDepth(size_t depth);
+
+    /// @brief Drops all snapshots.
+    static void clear();
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_SNAPSHOTS_H
@@ -0,0 +1,211 @@
+#include <config.h>
+
+#include <dhcpsrv/cfgmgr.h>
+#include <dhcpsrv/subnet.h>
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <interfaces_cmds_family.h>
+#include <interfaces_cmds_log.h>
+#include <interfaces_cmds_tag_index.h>
+#include <interfaces_cmds_trace.h>
+
+#include <boost/weak_ptr.hpp>
+
+using namespace isc::dhcp;
+using namespace isc::data;
+using namespace isc::interfaces_cmds;
+using namespace std;
+
+namespace {
+
+typedef vector<SubnetID> SubnetIDList;
+
+/// @brief Subnet IDs per user-context value.
+typedef unordered_map<string, SubnetIDList> ValueIndex;
+
+/// @brief Values per user-context key.
+typedef unordered_map<string, ValueIndex> KeyIndex;
+
+mutex index_mutex;
+
+/// @brief Configuration the index was built from.
+///
+/// A weak pointer is used so the index does not keep an old configuration
+/// alive, and a committed configuration never compares equal to it.
+boost::weak_ptr<SrvConfig> index_config;
+
+KeyIndex tag_index;
+
+/// @brief Subnets the index was built from, in ascending order of their IDs.
+///
+/// Weak pointers keep the identity of the subnets without keeping them
+/// alive, a replaced subnet never compares equal to its indexed version.
+vector<boost::weak_ptr<Subnet>> index_subnets;
+
+// Values are compared by their JSON representation, which includes the
+// type: the string "12" does not match the integer 12, nor "true" the
+// boolean true.
+string
+valueKey(const ConstElementPtr& value) {
+    return (value->str());
+}
+
+template<typename SubnetCollection>
+void
+indexSubnets(const SubnetCollection* subnets) {
+    // Subnets are iterated in ascending order of their IDs, so each list
+    // of the index remains sorted without any extra work.
+    for (auto const& subnet : *subnets) {
+        index_subnets.push_back(subnet);
+        ConstElementPtr context = subnet->getContext();
+        if (!context || context->getType() != Element::map) {
+            continue;
+        }
+        for (auto const& entry : context->mapValue()) {
+            tag_index[entry.first][valueKey(entry.second)].push_back(subnet->getID());
+        }
+    }
+}
+
+// Subnets may be added, replaced or deleted after the commit by other
+// hooks (e.g. subnet4-add or subnet4-update of subnet_cmds), which changes
+// the collection without a new configuration. The subnets are compared by
+// identity with the indexed ones, which is much cheaper than parsing every
+// user-context again.
+template<typename SubnetCollection>
+bool
+subnetsChanged(const SubnetCollection* subnets) {
+    if (subnets->size() != index_subnets.size()) {
+        return (true);
+    }
+    auto indexed = index_subnets.begin();
+    for (auto const& subnet : *subnets) {
+        if (indexed->owner_before(subnet) || subnet.owner_before(*indexed)) {
+            return (true);
+        }
+        ++indexed;
+    }
+    return (false);
+}
+
+// Must be called with the mutex held.
+template<typename Family>
+void
+rebuildIfStale() {
+    SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+    const typename Family::SubnetCollection* subnets = Family::getAll(current);
+    if (index_config.lock() == current && !subnetsChanged(subnets)) {
+        return;
+    }
+
+    tag_index.clear();
+    index_subnets.clear();
+    indexSubnets(subnets);
+    index_config = current;
+
+    LOG_INFO(interfaces_cmds_logger, INTERFACES_CMDS_TAG_INDEX_BUILT)
+        .arg(subnets->size())
+        .arg(tag_index.size());
+}
+
+// A user-context may also be changed in place on an indexed subnet, so the
+// candidates returned by the index are confirmed against the live subnet.
+// Only the matched subnets are inspected.
+template<typename SubnetPtrType>
+bool
+contextMatches(const SubnetPtrType& subnet, const ConstElementPtr& selector) {
+    if (!subnet) {
+        return (false);
+    }
+    ConstElementPtr context = subnet->getContext();
+    if (!context || context->getType() != Element::map) {
+        return (false);
+    }
+    for (auto const& entry : selector->mapValue()) {
+        ConstElementPtr value = context->get(entry.first);
+        if (!value || valueKey(value) != valueKey(entry.second)) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+template<typename Family>
+vector<SubnetID>
+SubnetTagIndex::find(const ConstElementPtr& selector) {
+    INTERFACES_CMDS_TRACE_SPAN("tag-index-lookup");
+    SubnetIDList result;
+    if (!selector || selector->getType() != Element::map || selector->empty()) {
+        return (result);
+    }
+
+    {
+        lock_guard<mutex> lock(index_mutex);
+        rebuildIfStale<Family>();
+
+        // Collect the posting list of every pair, a missing pair means that
+        // no subnet can match.
+        vector<const SubnetIDList*> lists;
+        for (auto const& entry : selector->mapValue()) {
+            auto key = tag_index.find(entry.first);
+            if (key == tag_index.end()) {
+                return (result);
+            }
+            auto value = key->second.find(valueKey(entry.second));
+            if (value == key->second.end()) {
+                return (result);
+            }
+            lists.push_back(&value->second);
+        }
+
+        // Intersect starting from the shortest list to keep the work
+        // proportional to the most selective pair.
+        sort(lists.begin(), lists.end(),
+             [](const SubnetIDList* a, const SubnetIDList* b) {
+                 return (a->size() < b->size());
+             });
+        result = *lists[0];
+        for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+            SubnetIDList intersection;
+            set_intersection(result.begin(), result.end(),
+                             lists[i]->begin(), lists[i]->end(),
+                             back_inserter(intersection));
+            result.swap(intersection);
+        }
+    }
+
+    SrvConfigPtr current = CfgMgr::instance().getCurrentCfg();
+    SubnetIDList confirmed;
+    confirmed.reserve(result.size());
+    for (auto const& id : result) {
+        if (contextMatches(Family::getSubnet(current, id), selector)) {
+            confirmed.push_back(id);
+        }
+    }
+
+    return (confirmed);
+}
+
+template vector<SubnetID> SubnetTagIndex::find<Family4>(const ConstElementPtr& selector);
+template vector<SubnetID> SubnetTagIndex::find<Family6>(const ConstElementPtr& selector);
+
+void
+SubnetTagIndex::clear() {
+    lock_guard<mutex> lock(index_mutex);
+    tag_index.clear();
+    index_subnets.clear();
+    index_config.reset();
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
@@ -0,0 +1,41 @@
+#ifndef INTERFACES_CMDS_TAG_INDEX_H
+#define INTERFACES_CMDS_TAG_INDEX_H
+
+#include <cc/data.h>
+#include <dhcpsrv/subnet_id.h>
+
+#include <vector>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Inverted index of the subnets user-context.
+///
+/// Maps every top-level user-context key/value pair of the current
+/// configuration to the list of subnet IDs carrying it. The index is bound
+/// to the configuration it was built from and is rebuilt only after a new
+/// configuration has been committed, so selectors do not parse every
+/// subnet user-context on each command.
+class SubnetTagIndex {
+public:
+    /// @brief Returns IDs of the subnets matching the selector.
+    ///
+    /// A subnet matches when its user-context contains every key of the
+    /// selector with an equal value.
+    ///
+    /// @tparam Family Protocol family traits, @c Family4 or @c Family6.
+    /// @param selector Map of user-context keys and expected values.
+    ///
+    /// @return Matching subnet IDs in ascending order.
+    template<typename Family>
+    static std::vector<dhcp::SubnetID>
+    find(const data::ConstElementPtr& selector);
+
+    /// @brief Drops the index, it is rebuilt on next lookup.
+    static void clear();
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif  // INTERFACES_CMDS_TAG_INDEX_H
@@ -0,0 +1,116 @@
+#include <config.h>
+
+#include <interfaces_cmds_trace.h>
+
+// Only the ring buffer needs out of line code, the static probes alone are
+// defined inline in the header.
+#if defined(INTERFACES_CMDS_TRACING)
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+using namespace isc::data;
+using namespace std;
+
+namespace {
+
+/// @brief Closed span.
+struct TraceEvent {
+    const char* name_;
+    int64_t start_;
+    int64_t duration_;
+    uint32_t tid_;
+};
+
+mutex trace_mutex;
+vector<TraceEvent> trace_events;
+
+/// @brief Position of the next event, also the number of events ever recorded.
+uint64_t trace_next = 0;
+
+// Chrome trace-event timestamps are in microseconds.
+int64_t
+now() {
+    return (chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t
+currentTid() {
+    thread_local uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+    return (tid);
+}
+
+void
+record(const char* name, int64_t start, int64_t duration) {
+    TraceEvent event = { name, start, duration, currentTid() };
+    lock_guard<mutex> lock(trace_mutex);
+    if (trace_events.size() < isc::interfaces_cmds::TraceBuffer::CAPACITY) {
+        trace_events.push_back(event);
+    } else {
+        trace_events[trace_next % isc::interfaces_cmds::TraceBuffer::CAPACITY] = event;
+    }
+    ++trace_next;
+}
+
+}  // namespace
+
+namespace isc {
+namespace interfaces_cmds {
+
+TraceSpan::TraceSpan(const char* name) : name_(name) {
+    INTERFACES_CMDS_PROBE(span_begin, name_);
+    start_ = now();
+}
+
+TraceSpan::~TraceSpan() {
+    record(name_, start_, now() - start_);
+    INTERFACES_CMDS_PROBE(span_end, name_);
+}
+
+ElementPtr
+TraceBuffer::dump(bool clear) {
+    ElementPtr events = Element::createList();
+    int64_t pid = static_cast<int64_t>(getpid());
+
+    lock_guard<mutex> lock(trace_mutex);
+    // Once the buffer is full the oldest event is the next to be overwritten.
+    size_t first = (trace_events.size() < CAPACITY ? 0 : trace_next % CAPACITY);
+    for (size_t i = 0; i < trace_events.size(); ++i) {
+        const TraceEvent& event = trace_events[(first + i) % trace_events.size()];
+        ElementPtr entry = Element::createMap();
+        entry->set("name", Element::create(string(event.name_)));
+        entry->set("cat", Element::create(string("interfaces_cmds")));
+        entry->set("ph", Element::create(string("X")));
+        entry->set("ts", Element::create(event.start_));
+        entry->set("dur", Element::create(event.duration_));
+        entry->set("pid", Element::create(pid));
+        entry->set("tid", Element::create(static_cast<int64_t>(event.tid_)));
+        events->add(entry);
+    }
+    if (clear) {
+        trace_events.clear();
+        trace_next = 0;
+    }
+
+    ElementPtr document = Element::createMap();
+    document->set("traceEvents", events);
+    document->set("displayTimeUnit", Element::create(string("ms")));
+    return (document);
+}
+
+void
+TraceBuffer::clear() {
+    lock_guard<mutex> lock(trace_mutex);
+    trace_events.clear();
+    trace_next = 0;
+}
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef INTERFACES_CMDS_TRACE_H
+#define INTERFACES_CMDS_TRACE_H
+
+// Tracing of the command phases, removed at compile time unless enabled:
+//
+// - INTERFACES_CMDS_TRACING records every span in a ring buffer which is
+//   returned as Chrome trace-event JSON by the 'interfaces-trace-dump'
+//   command.
+// - INTERFACES_CMDS_USDT emits the interfaces_cmds:span_begin and
+//   interfaces_cmds:span_end static probes with the span name, for perf or
+//   bpftrace. A probe is a single nop while nothing is attached.
+
+#if defined(INTERFACES_CMDS_USDT)
+#include <sys/sdt.h>
+#define INTERFACES_CMDS_PROBE(probe, name) DTRACE_PROBE1(interfaces_cmds, probe, name)
+#else
+#define INTERFACES_CMDS_PROBE(probe, name)
+#endif
+
+#if defined(INTERFACES_CMDS_TRACING)
+#include <cc/data.h>
+#endif
+
+#if defined(INTERFACES_CMDS_TRACING) || defined(INTERFACES_CMDS_USDT)
+
+#include <cstdint>
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Traces the scope it lives in.
+///
+/// With the static probes only, the span is defined inline so it costs the
+/// probes nops and no call.
+class TraceSpan {
+public:
+#if defined(INTERFACES_CMDS_TRACING)
+    /// @brief Constructor, opens the span.
+    ///
+    /// @param name Span name, must be a string literal.
+    explicit TraceSpan(const char* name);
+
+    /// @brief Destructor, closes the span.
+    ~TraceSpan();
+#else
+    /// @brief Constructor, opens the span.
+    ///
+    /// @param name Span name, must be a string literal.
+    explicit TraceSpan(const char* name) : name_(name) {
+        INTERFACES_CMDS_PROBE(span_begin, name_);
+    }
+
+    /// @brief Destructor, closes the span.
+    ~TraceSpan() {
+        INTERFACES_CMDS_PROBE(span_end, name_);
+    }
+#endif
+
+private:
+    const char* name_;
+
+#if defined(INTERFACES_CMDS_TRACING)
+    int64_t start_;
+#endif
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#define INTERFACES_CMDS_TRACE_CONCAT_(a, b) a##b
+#define INTERFACES_CMDS_TRACE_CONCAT(a, b) INTERFACES_CMDS_TRACE_CONCAT_(a, b)
+#define INTERFACES_CMDS_TRACE_SPAN(name) \
+    ::isc::interfaces_cmds::TraceSpan INTERFACES_CMDS_TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+#else
+
+#define INTERFACES_CMDS_TRACE_SPAN(name)
+
+#endif
+
+#if defined(INTERFACES_CMDS_TRACING)
+
+namespace isc {
+namespace interfaces_cmds {
+
+/// @brief Ring buffer of the closed spans.
+class TraceBuffer {
+public:
+    /// @brief Number of spans kept, the oldest ones are overwritten.
+    static const size_t CAPACITY = 4096;
+
+    /// @brief Returns the kept spans as a Chrome trace-event document.
+    ///
+    /// @param clear Drops the returned spans when true.
+    static data::ElementPtr dump(bool clear);
+
+    /// @brief Drops all spans.
+    static void clear();
+};
+
+}  // namespace interfaces_cmds
+}  // namespace isc
+
+#endif
+
+#endif  // INTERFACES_CMDS_TRACE_H